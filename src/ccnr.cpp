@@ -62,14 +62,17 @@ bool ls_solver::make_space()
     return true;
 }
 
-void ls_solver::build_neighborhood()
+void ls_solver::build_neighborhood(const vector<int>* only_vars)
 {
     vector<bool> neighbor_flag(_num_vars+1);
     for (uint32_t j = 0; j < neighbor_flag.size(); ++j) {
         neighbor_flag[j] = 0;
     }
-    for (int v = 1; v <= _num_vars; ++v) {
+    const int num = only_vars ? (int)only_vars->size() : _num_vars;
+    for (int i = 0; i < num; ++i) {
+        const int v = only_vars ? (*only_vars)[i] : i+1;
         variable *vp = &(_vars[v]);
+        vp->neighbor_var_nums.clear();
         for (lit lv: vp->literals) {
             int c = lv.clause_num;
             for (lit lc: _clauses[c].literals) {
@@ -95,6 +98,7 @@ bool ls_solver::local_search(
 ) {
     bool result = false;
     _random_gen.seed(_random_seed);
+    _mems = 0;
     _best_found_cost = _num_clauses;
     _conflict_ct.clear();
     _conflict_ct.resize(_num_vars+1,0);
@@ -110,7 +114,9 @@ bool ls_solver::local_search(
             int flipv = pick_var();
             flip(flipv);
             for(int var_idx:_unsat_vars) ++_conflict_ct[var_idx];
-            if (_mems > _mems_limit) {
+            if (_mems > _mems_limit
+                || (_interrupt && _interrupt->load(std::memory_order_relaxed))
+            ) {
                 return result;
             }
 
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <atomic>
 #include "ccnr_mersenne.h"
 
 using std::vector;
@@ -103,6 +104,9 @@ class ls_solver
         return _best_found_cost;
     }
     void set_verbosity(uint32_t verb);
+    void set_seed(int seed) { _random_seed = seed; }
+    ///local_search() returns soon after this is set
+    void set_interrupt(const std::atomic<bool>* interrupt) { _interrupt = interrupt; }
 
     //formula
     vector<variable> _vars;
@@ -124,7 +128,8 @@ class ls_solver
 
     //functions for buiding data structure
     bool make_space();
-    void build_neighborhood();
+    ///Of the given variables only, or all of them
+    void build_neighborhood(const vector<int>* only_vars = nullptr);
     int get_cost() { return _unsat_clauses.size(); }
 
     private:
@@ -136,6 +141,7 @@ class ls_solver
     //aiding data structure
     Mersenne _random_gen; //random generator
     int _random_seed;
+    const std::atomic<bool>* _interrupt = nullptr;
 
     ///////////////////////////
     //algorithmic parameters
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "solver.h"
 #include "ccnr.h"
 #include "sqlstats.h"
+#include <numeric>
 //#define SLOW_DEBUG
 
 using namespace CMSat;
@@ -39,6 +40,9 @@ CMS_ccnr::CMS_ccnr(Solver* _solver) :
 {
     ls_s = new CCNR::ls_solver(solver->conf.sls_ccnr_asipire);
     ls_s->set_verbosity(solver->conf.verbosity);
+    sls_to_outer.push_back(0);
+    sls_var_set.push_back(0);
+    is_dirty.push_back(0);
 }
 
 CMS_ccnr::~CMS_ccnr()
@@ -66,7 +70,10 @@ lbool CMS_ccnr::main_alter(int64_t mems, vector<uint8_t>& ret)
     if (res) {
       ret.clear();
       ret.resize(solver->nVars());
-      for(uint32_t i = 0; i < solver->nVars(); i++) ret[i] = ls_s->_solution[i+1];
+      for(uint32_t v = 1; v < sls_to_outer.size(); v++) {
+          const uint32_t var = inter_var(v);
+          if (var != var_Undef) ret[var] = ls_s->_solution[v];
+      }
     }
     return res == 1 ? l_True : l_Undef;
 }
@@ -90,9 +97,10 @@ lbool CMS_ccnr::main(const uint32_t num_sls_called)
         return l_Undef;
     }
 
-    vector<bool> phases(solver->nVars()+1);
-    for(uint32_t i = 0; i < solver->nVars(); i++) {
-        phases[i+1] = solver->varData[i].best_polarity;
+    vector<bool> phases(sls_to_outer.size());
+    for(uint32_t v = 1; v < sls_to_outer.size(); v++) {
+        const uint32_t var = inter_var(v);
+        phases[v] = var != var_Undef && solver->varData[var].best_polarity;
     }
 
     int res = ls_s->local_search(&phases, solver->conf.yalsat_max_mems*2*1000*1000,
@@ -113,11 +121,11 @@ lbool CMS_ccnr::main(const uint32_t num_sls_called)
 }
 
 template<class T>
-CMS_ccnr::add_cl_ret CMS_ccnr::add_this_clause(const T& cl)
+CMS_ccnr::add_cl_ret CMS_ccnr::add_this_clause(const T& cl, const int32_t id)
 {
     uint32_t sz = 0;
     bool sat = false;
-    yals_lits.clear();
+    cl_lits.clear();
     for(size_t i3 = 0; i3 < cl.size(); i3++) {
         Lit lit = cl[i3];
         assert(solver->varData[lit.var()].removed == Removed::none);
@@ -135,12 +143,11 @@ CMS_ccnr::add_cl_ret CMS_ccnr::add_this_clause(const T& cl)
         } else if (val == l_False) {
             continue;
         }
-        int l = lit.var()+1;
-        l *= lit.sign() ? -1 : 1;
-        yals_lits.push_back(l);
+        cl_lits.push_back(lit);
         sz++;
     }
     if (sat) {
+        cl_lits.clear();
         return add_cl_ret::skipped_cl;
     }
     if (sz == 0) {
@@ -149,35 +156,138 @@ CMS_ccnr::add_cl_ret CMS_ccnr::add_this_clause(const T& cl)
         return add_cl_ret::unsat;
     }
 
+    yals_lits.clear();
+    for(const Lit lit: cl_lits) {
+        int l = sls_var(lit.var());
+        l *= lit.sign() ? -1 : 1;
+        yals_lits.push_back(l);
+    }
+    cl_lits.clear();
+
+    if (ls_s->_clauses.size() <= cl_num) ls_s->_clauses.resize(cl_num+1);
+    if (slot_id.size() <= cl_num) {
+        slot_id.resize(cl_num+1);
+        slot_epoch.resize(cl_num+1);
+    }
     for(auto& lit: yals_lits) {
-        ls_s->_clauses[cl_num].literals.push_back(CCNR::lit(lit, cl_num));
+        const CCNR::lit l(lit, cl_num);
+        ls_s->_clauses[cl_num].literals.push_back(l);
+        ls_s->_vars[l.var_num].literals.push_back(l);
+        mark_dirty(l.var_num);
     }
+    slot_id[cl_num] = id;
+    slot_epoch[cl_num] = epoch;
+    id_to_slot[id] = cl_num;
     cl_num++;
+    num_added++;
 
     return add_cl_ret::added_cl;
 }
 
+uint32_t CMS_ccnr::sls_var(const uint32_t var)
+{
+    const uint32_t outer = solver->map_inter_to_outer(var);
+    if (outer_to_sls.size() <= outer) outer_to_sls.resize(solver->nVarsOuter(), 0);
+    if (outer_to_sls[outer] == 0) {
+        outer_to_sls[outer] = sls_to_outer.size();
+        sls_to_outer.push_back(outer);
+        sls_var_set.push_back(0);
+        is_dirty.push_back(0);
+        ls_s->_vars.resize(sls_to_outer.size());
+    }
+    return outer_to_sls[outer];
+}
+
+uint32_t CMS_ccnr::inter_var(const uint32_t sls_v) const
+{
+    const uint32_t var = solver->map_outer_to_inter(sls_to_outer[sls_v]);
+    if (var >= solver->nVars() || solver->varData[var].removed != Removed::none) {
+        return var_Undef;
+    }
+    return var;
+}
+
+void CMS_ccnr::mark_dirty(const int v)
+{
+    if (is_dirty[v]) return;
+    is_dirty[v] = 1;
+    dirty_vars.push_back(v);
+}
+
+//Moves the last clause into slot 'c'
+void CMS_ccnr::remove_slot(const uint32_t c)
+{
+    for(const CCNR::lit& l: ls_s->_clauses[c].literals) {
+        auto& occ = ls_s->_vars[l.var_num].literals;
+        for(size_t i = 0; i < occ.size(); i++) {
+            if (occ[i].clause_num == (int)c) {
+                occ[i] = occ.back();
+                occ.pop_back();
+                break;
+            }
+        }
+        mark_dirty(l.var_num);
+    }
+    auto it = id_to_slot.find(slot_id[c]);
+    if (it != id_to_slot.end() && it->second == c) id_to_slot.erase(it);
+
+    const uint32_t last = cl_num-1;
+    if (c != last) {
+        std::swap(ls_s->_clauses[c].literals, ls_s->_clauses[last].literals);
+        for(CCNR::lit& l: ls_s->_clauses[c].literals) {
+            l.clause_num = c;
+            for(CCNR::lit& o: ls_s->_vars[l.var_num].literals) {
+                if (o.clause_num == (int)last) {
+                    o.clause_num = c;
+                    break;
+                }
+            }
+        }
+        slot_id[c] = slot_id[last];
+        slot_epoch[c] = slot_epoch[last];
+        it = id_to_slot.find(slot_id[c]);
+        if (it != id_to_slot.end() && it->second == last) it->second = c;
+    }
+    ls_s->_clauses[last].literals.clear();
+    cl_num--;
+    num_removed++;
+}
+
 bool CMS_ccnr::init_problem()
 {
     if (solver->check_assumptions_contradict_foced_assignment()) return false;
     SLOW_DEBUG_DO(solver->check_stats());
+    const uint64_t added_before = num_added;
+    const uint64_t removed_before = num_removed;
+    epoch++;
+
+    //Clauses of variables set since the last call are taken out, and added
+    //back below without the variable. Epoch 0 marks them
+    for(uint32_t v = 1; v < sls_to_outer.size(); v++) {
+        if (sls_var_set[v]) continue;
+        const uint32_t var = solver->map_outer_to_inter(sls_to_outer[v]);
+        if (solver->value(var) == l_Undef) continue;
+        sls_var_set[v] = 1;
+        for(const CCNR::lit& l: ls_s->_vars[v].literals) slot_epoch[l.clause_num] = 0;
+    }
 
-    ls_s->_num_vars = solver->nVars();
-    ls_s->_num_clauses = solver->longIrredCls.size() + solver->binTri.irredBins;
-    ls_s->make_space();
+    auto add_or_keep = [&](const auto& cl, const int32_t id) -> bool {
+        const auto it = id_to_slot.find(id);
+        if (it != id_to_slot.end() && slot_epoch[it->second] != 0) {
+            slot_epoch[it->second] = epoch;
+            return true;
+        }
+        return add_this_clause(cl, id) != add_cl_ret::unsat;
+    };
 
-    vector<Lit> this_clause;
+    vector<Lit> bin(2);
     for(size_t i2 = 0; i2 < solver->nVars()*2; i2++) {
         Lit lit = Lit::toLit(i2);
         for(const Watched& w: solver->watches[lit]) {
             if (w.isBin() && !w.red() && lit < w.lit2()) {
-                this_clause.clear();
-                this_clause.push_back(lit);
-                this_clause.push_back(w.lit2());
-
-                if (add_this_clause(this_clause) == add_cl_ret::unsat) {
-                    return false;
-                }
+                bin[0] = lit;
+                bin[1] = w.lit2();
+                if (!add_or_keep(bin, w.get_id())) return false;
             }
         }
     }
@@ -185,36 +295,30 @@ bool CMS_ccnr::init_problem()
         const Clause* cl = solver->cl_alloc.ptr(offs);
         assert(!cl->freed());
         assert(!cl->get_removed());
+        if (!add_or_keep(*cl, cl->stats.id)) return false;
+    }
 
-        if (add_this_clause(*cl) == add_cl_ret::unsat) {
-            return false;
-        }
+    //Whatever wasn't seen is gone from the solver. Backwards, so the clause
+    //moved into the hole is one that's kept
+    for(uint32_t c = cl_num; c-- > 0;) {
+        if (slot_epoch[c] != epoch) remove_slot(c);
     }
 
-    //Shrink the space if we have to
-    assert(ls_s->_num_clauses >= (int)cl_num);
+    ls_s->_num_vars = sls_to_outer.size()-1;
     ls_s->_num_clauses = (int)cl_num;
     ls_s->make_space();
+    ls_s->build_neighborhood(&dirty_vars);
+    for(const int v: dirty_vars) is_dirty[v] = 0;
+    dirty_vars.clear();
 
-    for (int c=0; c < ls_s->_num_clauses; c++) {
-        for(CCNR::lit item: ls_s->_clauses[c].literals) {
-            int v = item.var_num;
-            ls_s->_vars[v].literals.push_back(item);
-        }
-    }
-    ls_s->build_neighborhood();
+    verb_print(2, "[ccnr] clause store cls: " << cl_num
+        << " vars: " << ls_s->_num_vars
+        << " added: " << num_added - added_before
+        << " removed: " << num_removed - removed_before);
 
     return true;
 }
 
-struct ClWeightSorter
-{
-    bool operator()(const CCNR::clause& a, const CCNR::clause& b)
-    {
-        return a.weight > b.weight;
-    }
-};
-
 struct VarAndVal {
     VarAndVal(uint32_t _var, long long _score) : var(_var), val(_score) {}
     uint32_t var;
@@ -237,17 +341,22 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_cls()
     SLOW_DEBUG_DO(for(const auto x: seen) assert(x == 0));
 
     vector<pair<uint32_t, double>> tobump_cl_var;
-    std::sort(ls_s->_clauses.begin(), ls_s->_clauses.end(), ClWeightSorter());
+    //The clauses are kept for the next call, so they can't be reordered
+    vector<uint32_t> by_weight(ls_s->_num_clauses);
+    std::iota(by_weight.begin(), by_weight.end(), 0);
+    std::sort(by_weight.begin(), by_weight.end(), [&](uint32_t a, uint32_t b) {
+        return ls_s->_clauses[a].weight > ls_s->_clauses[b].weight;
+    });
     uint32_t vars_bumped = 0;
     uint32_t individual_vars_bumped = 0;
-    for(const auto& c: ls_s->_clauses) {
+    for(const uint32_t at: by_weight) {
+        const auto& c = ls_s->_clauses[at];
         if (vars_bumped > solver->conf.sls_how_many_to_bump)
             break;
 
         for(uint32_t i = 0; i < c.literals.size(); i++) {
-            uint32_t v = c.literals[i].var_num-1;
-            if (v < solver->nVars() &&
-                solver->varData[v].removed == Removed::none &&
+            uint32_t v = inter_var(c.literals[i].var_num);
+            if (v != var_Undef &&
                 solver->value(v) == l_Undef &&
                 seen[v] < solver->conf.sls_bump_var_max_n_times)
             {
@@ -269,8 +378,9 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_cls()
 vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_var_scores()
 {
     vector<VarAndVal> vs;
-    for(uint32_t i = 1; i < ls_s->_vars.size(); i++) {
-        vs.push_back(VarAndVal(i-1, ls_s->_vars[i].score));
+    for(uint32_t i = 1; i < sls_to_outer.size(); i++) {
+        const uint32_t var = inter_var(i);
+        if (var != var_Undef) vs.push_back(VarAndVal(var, ls_s->_vars[i].score));
     }
     std::sort(vs.begin(), vs.end(), VarValSorter());
 
@@ -293,11 +403,13 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_conflict_ct()
     }
 
     for(uint32_t i = 1; i < ls_s->_conflict_ct.size(); i++) {
+        const uint32_t var = inter_var(i);
+        if (var == var_Undef) continue;
         double val = ls_s->_conflict_ct[i];
         if (mymax > 0) {
-            tobump.push_back(std::make_pair(i-1, (double)val/(double)mymax * 3.0));
+            tobump.push_back(std::make_pair(var, (double)val/(double)mymax * 3.0));
         } else {
-            tobump.push_back(std::make_pair(i-1, 0));
+            tobump.push_back(std::make_pair(var, 0));
         }
 //         if (tobump.back().second > 0) {
 //             cout << "var: " << tobump.back().first << " bump by: " << tobump.back().second << endl;
@@ -315,10 +427,12 @@ lbool CMS_ccnr::deal_with_solution(int res, const uint32_t num_sls_called)
             cout << endl;
         }
 
-        for(size_t i = 0; i < solver->nVars(); i++) {
-            solver->varData[i].stable_polarity = ls_s->_best_solution[i+1];
+        for(uint32_t v = 1; v < sls_to_outer.size(); v++) {
+            const uint32_t var = inter_var(v);
+            if (var == var_Undef) continue;
+            solver->varData[var].stable_polarity = ls_s->_best_solution[v];
             if (res) {
-                solver->varData[i].best_polarity = ls_s->_best_solution[i+1];
+                solver->varData[var].best_polarity = ls_s->_best_solution[v];
             }
         }
     }
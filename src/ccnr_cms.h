@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include <cstdint>
 #include <utility>
+#include <unordered_map>
 #include "solvertypes.h"
 
 namespace CMSat {
@@ -63,11 +64,34 @@ private:
 
     enum class add_cl_ret {added_cl, skipped_cl, unsat};
     template<class T>
-    add_cl_ret add_this_clause(const T& cl);
+    add_cl_ret add_this_clause(const T& cl, const int32_t id);
     vector<int> yals_lits;
+    vector<Lit> cl_lits;
     vector<uint32_t>& seen;
     vector<Lit>& toClear;
 
+    /************************************/
+    /* Clause store kept between calls  */
+    /************************************/
+    //Clause IDs change whenever the literals do, so init_problem() only adds
+    //clauses with IDs it has not seen and removes those that are gone. CCNR
+    //variables are outer variables, so renumbering doesn't matter either
+    uint32_t sls_var(const uint32_t var);
+    uint32_t inter_var(const uint32_t sls_v) const; ///<var_Undef if gone
+    void remove_slot(const uint32_t c);
+    void mark_dirty(const int v);
+    vector<uint32_t> sls_to_outer; ///<[0] unused, like CCNR's variables
+    vector<uint32_t> outer_to_sls; ///<0 if the variable is not in the store
+    vector<char> sls_var_set;      ///<Clauses were cleaned of it already
+    vector<int32_t> slot_id;
+    vector<uint32_t> slot_epoch;
+    std::unordered_map<int32_t, uint32_t> id_to_slot;
+    uint32_t epoch = 0;
+    vector<int> dirty_vars;
+    vector<char> is_dirty;
+    uint64_t num_added = 0;
+    uint64_t num_removed = 0;
+
     //Bumping of variable scores
     vector<pair<uint32_t, double>> get_bump_based_on_cls();
     vector<pair<uint32_t, double>> get_bump_based_on_var_scores();
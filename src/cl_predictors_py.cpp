@@ -62,12 +62,12 @@ int ClPredictorsPy::set_up_input(
     int x = 0;
 
     const ClauseStatsExtra& extra_stats = solver->red_stats_extra[cl->stats.extra_pos];
-    uint32_t last_touched_any_diff = sumConflicts - (uint64_t)cl->stats.last_touched_any;
+    uint32_t last_touched_any_diff = sumConflicts - (uint64_t)extra_stats.last_touched_any;
     double time_inside_solver = sumConflicts - (uint64_t)extra_stats.introduced_at_conflict;
 
     at[x++] = cl->stats.is_ternary_resolvent;
     at[x++] = cl->stats.which_red_array;
-    at[x++] = cl->stats.last_touched_any;
+    at[x++] = extra_stats.last_touched_any;
     at[x++] = act_ranking_rel;
     at[x++] = uip1_ranking_rel;
     at[x++] = prop_ranking_rel;
@@ -0,0 +1,117 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "cl_predictors_trees.h"
+#include "clause.h"
+#include "solver.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+extern char predictor_short_json[];
+extern unsigned int predictor_short_json_len;
+
+extern char predictor_long_json[];
+extern unsigned int predictor_long_json_len;
+
+extern char predictor_forever_json[];
+extern unsigned int predictor_forever_json_len;
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+ClPredictorsTrees::ClPredictorsTrees(const uint32_t num_helpers)
+{
+    if (num_helpers > 0) helpers = std::make_unique<HelperPool>(num_helpers);
+}
+
+bool ClPredictorsTrees::load_one(const predict_type t, const char* buf, const size_t len)
+{
+    std::string err;
+    if (!models[t].load_xgb_json(buf, len, err)) {
+        cout << "ERROR: cannot load tree model: " << err << endl;
+        return false;
+    }
+    if (models[t].num_features() > PRED_COLS) {
+        cout << "ERROR: tree model uses " << models[t].num_features()
+        << " features, we only have " << PRED_COLS << endl;
+        return false;
+    }
+    return true;
+}
+
+int ClPredictorsTrees::load_models(const std::string& short_fname,
+                               const std::string& long_fname,
+                               const std::string& forever_fname,
+                               const std::string&)
+{
+    const std::string fnames[3] = {short_fname, long_fname, forever_fname};
+    for(int i = 0; i < 3; i++) {
+        std::ifstream f(fnames[i]);
+        if (!f) {
+            cout << "ERROR: cannot open tree model " << fnames[i] << endl;
+            return 0;
+        }
+        std::stringstream s;
+        s << f.rdbuf();
+        const std::string buf = s.str();
+        if (!load_one((predict_type)i, buf.data(), buf.size())) return 0;
+    }
+    return 1;
+}
+
+int ClPredictorsTrees::load_models_from_buffers()
+{
+    if (!load_one(short_pred, predictor_short_json, predictor_short_json_len)
+        || !load_one(long_pred, predictor_long_json, predictor_long_json_len)
+        || !load_one(forever_pred, predictor_forever_json, predictor_forever_json_len)
+    ) {
+        return 1;
+    }
+    return 0;
+}
+
+void ClPredictorsTrees::predict_all(
+    float* const data,
+    const uint32_t num)
+{
+    for(auto& o: out) o.resize(num);
+    auto run = [&](size_t b, size_t e) {
+        for(int i = 0; i < 3; i++) {
+            models[i].predict(data, b, e, PRED_COLS, out[i].data());
+        }
+    };
+    if (helpers && num >= 1024) helpers->parallel_for(num, run);
+    else run(0, num);
+}
+
+void ClPredictorsTrees::get_prediction_at(ClauseStatsExtra& extdata, const uint32_t at)
+{
+    extdata.pred_short_use = (double)out[short_pred][at];
+    extdata.pred_long_use = (double)out[long_pred][at];
+    extdata.pred_forever_use = (double)out[forever_pred][at];
+}
+
+void ClPredictorsTrees::finish_all_predict()
+{
+}
@@ -0,0 +1,72 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef _CLPREDICTORS_TREES_H__
+#define _CLPREDICTORS_TREES_H__
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "clause.h"
+#include "cl_predictors_abs.h"
+#include "treeensemble.h"
+#include "helperpool.h"
+
+using std::vector;
+
+namespace CMSat {
+
+/**
+@brief Scores clauses with the built-in TreeEnsemble evaluator
+
+Reads the same XGBoost JSON models as ClPredictorsXGB, but evaluates them
+itself, with a fixed cost per clause. It can split a batch with helper threads.
+*/
+class ClPredictorsTrees : public ClPredictorsAbst
+{
+public:
+    explicit ClPredictorsTrees(const uint32_t num_helpers);
+    virtual ~ClPredictorsTrees() = default;
+    virtual int load_models(const std::string& short_fname,
+                     const std::string& long_fname,
+                     const std::string& forever_fname,
+                     const std::string& best_feats_fname) override;
+    virtual int load_models_from_buffers() override;
+
+    virtual void predict_all(
+        float* const data,
+        const uint32_t num) override;
+
+    virtual void get_prediction_at(ClauseStatsExtra& extdata, const uint32_t at) override;
+    virtual void finish_all_predict() override;
+
+private:
+    bool load_one(const predict_type t, const char* buf, const size_t len);
+    TreeEnsemble models[3];
+    vector<float> out[3];
+    std::unique_ptr<HelperPool> helpers;
+};
+
+}
+
+#endif
@@ -48,4 +48,25 @@ cl_abst_type calcAbstraction(const T& ps)
     return abstraction;
 }
 
+//Second signature word, only kept in the clause. Uses a multiplicative hash
+//so its collisions are independent from the ones of abst_var()
+inline cl_abst_type abst_var2(const uint32_t v)
+{
+    return 1U << ((v * 0x9E3779B1U) >> 27);
+}
+
+template <class T>
+cl_abst_type calcAbstraction2(const T& ps)
+{
+    cl_abst_type abstraction = 0;
+    if (ps.size() > 50) {
+        return ~((cl_abst_type)(0ULL));
+    }
+
+    for (auto l: ps)
+        abstraction |= abst_var2(l.var());
+
+    return abstraction;
+}
+
 #endif //__CL_ABSTRACTION__H__
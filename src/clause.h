@@ -124,7 +124,6 @@ struct ClauseStats
         which_red_array = 7; //intentionally breaking it so we catch bugs, 7 NEVER exists
         locked_for_data_gen = 0;
         is_ternary_resolvent = 0;
-        activity = 0;
         is_tracked = false;
     }
 
@@ -137,15 +136,12 @@ struct ClauseStats
     uint32_t locked_for_data_gen:1;
     uint32_t is_ternary_resolvent:1;
     uint32_t is_tracked:1;
-    union {
-        float   activity;
-        uint32_t hash_val; //used in BreakID to remove equivalent clauses
-    };
-    uint32_t last_touched_any = 0;
     int32_t id;
 
-    #if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
+    ///Redundant clauses only: their ClauseStatsExtra in red_stats_extra
     uint32_t extra_pos = numeric_limits<uint32_t>::max();
+
+    #if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
     uint32_t uip1_used = 0; ///N.o. times clause was used during 1st UIP generation in this RDB
     uint32_t props_made = 0; ///<Number of times caused propagation
     #endif
@@ -157,8 +153,6 @@ struct ClauseStats
 
         //Combine stats
         ret.glue = std::min(first.glue, second.glue);
-        ret.activity = std::max(first.activity, second.activity);
-        ret.last_touched_any = std::max(first.last_touched_any, second.last_touched_any);
         ret.locked_for_data_gen = std::max(first.locked_for_data_gen, second.locked_for_data_gen);
         ret.is_ternary_resolvent = first.is_ternary_resolvent;
         ret.ttl = std::max(first.ttl, second.ttl);
@@ -192,9 +186,18 @@ struct ClauseStats
     #endif
 };
 
-#if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
+/**
+@brief Statistics of a redundant clause kept outside of the clause
+
+Only conflict analysis and reduceDB use them, so they are in red_stats_extra,
+at ClauseStats::extra_pos, and propagation never loads them with the clause.
+*/
 struct ClauseStatsExtra
 {
+    float activity = 0;
+    uint32_t last_touched_any = 0;
+
+    #if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
     //TODO add new LBD definitions:
     //LBD computed over assigned TRUE literals only
     //LBD computed over assigned FALSE literals only
@@ -305,11 +308,14 @@ struct ClauseStatsExtra
 
         stats.reset_rdb_stats();
     }
+    #endif
 
     static ClauseStatsExtra combineStats(const ClauseStatsExtra& first, const ClauseStatsExtra& second)
     {
         //Create to-be-returned data
         ClauseStatsExtra ret = first;
+        ret.activity = std::max(first.activity, second.activity);
+        ret.last_touched_any = std::max(first.last_touched_any, second.last_touched_any);
 
         #if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
         if (first.introduced_at_conflict == 0) {
@@ -342,7 +348,6 @@ struct ClauseStatsExtra
         return ret;
     }
 };
-#endif
 
 inline std::ostream& operator<<(std::ostream& os, const ClauseStats& stats)
 {
@@ -358,11 +363,19 @@ Literals are allocated by an external allocator that allocates enough space
 for the class that it can hold the literals as well. I.e. it malloc()-s
     sizeof(Clause)+LENGHT*sizeof(Lit)
 to hold the clause.
+
+The header is laid out cold-to-hot: the statistics and the abstractions,
+which propagation never reads, come first. The flags word and the size sit
+right in front of the literals, so visiting a short clause during
+propagation touches one contiguous run of memory.
 */
 class Clause
 {
 public:
     ClauseStats stats;
+    cl_abst_type abst;
+    cl_abst_type abst2; ///<Checked after 'abst', which is all that occur watches hold
+
     uint32_t isRed:1; ///<Is the clause a redundant clause?
     uint32_t isRemoved:1; ///<Is this clause queued for removal?
     uint32_t isFreed:1; ///<Has this clause been marked as freed by the ClauseAllocator ?
@@ -374,6 +387,7 @@ public:
     uint32_t reloced:1;
     uint32_t disabled:1;
     uint32_t tried_to_remove:1;
+    uint32_t mySize;
 
     Lit* getData()
     {
@@ -385,16 +399,11 @@ public:
         return reinterpret_cast<const Lit*>(reinterpret_cast<const char*>(this) + sizeof(Clause));
     }
 
-public:
-    cl_abst_type abst;
-    uint32_t mySize;
-
     template<class V>
-    Clause(const V& ps, const uint32_t _introduced_at_conflict, const uint32_t _ID)
+    Clause(const V& ps, const uint32_t _ID)
     {
         //assert(ps.size() > 2);
 
-        stats.last_touched_any = _introduced_at_conflict;
         assert(_ID > 0);
         stats.id = _ID;
 
@@ -452,6 +461,7 @@ public:
     void recalc_abstraction()
     {
         abst = calcAbstraction(*this);
+        abst2 = calcAbstraction2(*this);
         must_recalc_abst = false;
     }
 
@@ -583,9 +593,7 @@ struct BinaryXor
 
 struct Sub0Ret {
     ClauseStats stats;
-    #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
     ClauseStatsExtra stats_extra;
-    #endif
     bool subsumedIrred = 0;
     uint32_t numSubsumed = 0;
 
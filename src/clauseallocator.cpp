@@ -57,6 +57,7 @@ using std::endl;
 #define ALLOC_GROW_MULT 1.5
 
 #define MAXSIZE ((1ULL << (EFFECTIVELY_USEABLE_BITS))-1)
+#define CONSOLIDATE_REGION_SIZE (1ULL << 20)
 
 namespace {
 // Number of BASE_DATA_TYPE elements needed to hold a clause of `num_lits`
@@ -77,6 +78,14 @@ inline ClOffset read_reloced_offset(const Clause* old)
     #endif
     return new_offset;
 }
+
+// Region of the consolidated stack the clause goes to: irredundant first,
+// then the redundant tiers in order
+inline uint32_t cl_region(const Clause* cl)
+{
+    if (!cl->red()) return 0;
+    return 1 + cl->stats.which_red_array;
+}
 } // namespace
 
 ClauseAllocator::ClauseAllocator()
@@ -92,58 +101,78 @@ ClauseAllocator::~ClauseAllocator()
     free(dataStart);
 }
 
-void* ClauseAllocator::allocEnough(
-    uint32_t num_lits
-) {
-    //Try to quickly find a place at the end of a dataStart
-    const uint64_t needed = clause_storage_elems(num_lits);
-
-    if (size + needed > capacity) {
-        //Grow by default, but don't go under or over the limits
-        uint64_t newcapacity = capacity * ALLOC_GROW_MULT;
-        newcapacity = std::max<size_t>(newcapacity, MIN_LIST_SIZE);
-        while (newcapacity < size+needed) {
-            newcapacity *= ALLOC_GROW_MULT;
-        }
-        assert(newcapacity >= size+needed);
-        newcapacity = std::min<size_t>(newcapacity, MAXSIZE);
+void ClauseAllocator::grow(const uint64_t needed)
+{
+    //Grow by default, but don't go under or over the limits
+    uint64_t newcapacity = capacity * ALLOC_GROW_MULT;
+    newcapacity = std::max<size_t>(newcapacity, MIN_LIST_SIZE);
+    while (newcapacity < size+needed) {
+        newcapacity *= ALLOC_GROW_MULT;
+    }
+    assert(newcapacity >= size+needed);
+    newcapacity = std::min<size_t>(newcapacity, MAXSIZE);
 
-        //Oops, not enough space anyway
-        if (newcapacity < size + needed) {
-            std::stringstream msg;
-            msg << "ERROR: memory manager can't handle the load."
+    //Oops, not enough space anyway
+    if (newcapacity < size + needed) {
+        std::stringstream msg;
+        msg << "ERROR: memory manager can't handle the load."
 #ifndef LARGE_OFFSETS
-                << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
+            << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
 #endif
-                << " size: " << size
-                << " needed: " << needed
-                << " newcapacity: " << newcapacity;
-            // Print to both streams so it shows up regardless of which is captured.
-            std::cerr << msg.str() << endl;
-            std::cout << msg.str() << endl;
-
-            throw std::bad_alloc();
-        }
+            << " size: " << size
+            << " needed: " << needed
+            << " newcapacity: " << newcapacity;
+        // Print to both streams so it shows up regardless of which is captured.
+        std::cerr << msg.str() << endl;
+        std::cout << msg.str() << endl;
+
+        throw std::bad_alloc();
+    }
 
-        //Reallocate data
-        BASE_DATA_TYPE* new_dataStart;
-        new_dataStart = (BASE_DATA_TYPE*)realloc(
-            dataStart
-            , newcapacity*sizeof(BASE_DATA_TYPE)
-        );
+    //Reallocate data
+    BASE_DATA_TYPE* new_dataStart;
+    new_dataStart = (BASE_DATA_TYPE*)realloc(
+        dataStart
+        , newcapacity*sizeof(BASE_DATA_TYPE)
+    );
+
+    //Realloc failed?
+    if (new_dataStart == nullptr) {
+        std::cerr
+        << "ERROR: while reallocating clause space"
+        << endl;
 
-        //Realloc failed?
-        if (new_dataStart == nullptr) {
-            std::cerr
-            << "ERROR: while reallocating clause space"
-            << endl;
+        throw std::bad_alloc();
+    }
+    dataStart = new_dataStart;
 
-            throw std::bad_alloc();
-        }
-        dataStart = new_dataStart;
+    //Update capacity to reflect the update
+    capacity = newcapacity;
+}
 
-        //Update capacity to reflect the update
-        capacity = newcapacity;
+/**
+@brief Makes room for num_cls clauses with num_lits literals in total
+
+Used when bulk-adding clauses, so the stack is reallocated (and copied) at
+most once instead of growing step-by-step
+*/
+void ClauseAllocator::reserve(const uint64_t num_cls, const uint64_t num_lits)
+{
+    const uint64_t needed =
+        num_cls*(clause_storage_elems(0)+1)
+        + (num_lits*sizeof(Lit) + sizeof(BASE_DATA_TYPE) - 1)/sizeof(BASE_DATA_TYPE);
+    if (size + needed > capacity) {
+        grow(needed);
+    }
+}
+
+void* ClauseAllocator::allocEnough(
+    uint32_t num_lits
+) {
+    //Try to quickly find a place at the end of a dataStart
+    const uint64_t needed = clause_storage_elems(num_lits);
+    if (size + needed > capacity) {
+        grow(needed);
     }
 
     //Add clause to the set
@@ -201,9 +230,11 @@ void ClauseAllocator::clauseFree(ClOffset offset)
 
 ClOffset ClauseAllocator::move_cl(
     ClOffset* newDataStart
-    , ClOffset*& new_ptr
+    , vector<ClOffset*>& new_ptrs
     , Clause* old
 ) {
+    assert(cl_region(old) < new_ptrs.size());
+    ClOffset*& new_ptr = new_ptrs[cl_region(old)];
     const uint64_t sizeNeeded = clause_storage_elems(old->size());
     memcpy(new_ptr, old, sizeNeeded*sizeof(BASE_DATA_TYPE));
 
@@ -220,7 +251,7 @@ ClOffset ClauseAllocator::move_cl(
 }
 
 void ClauseAllocator::move_one_watchlist(
-    watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr)
+    watch_subarray& ws, ClOffset* newDataStart, vector<ClOffset*>& new_ptrs)
 {
     for(Watched& w: ws) {
         if (w.isClause()) {
@@ -229,7 +260,7 @@ void ClauseAllocator::move_one_watchlist(
             const Lit blocked = w.getBlockedLit();
             const ClOffset new_offset = old->reloced
                 ? read_reloced_offset(old)
-                : move_cl(newDataStart, new_ptr, old);
+                : move_cl(newDataStart, new_ptrs, old);
             w = Watched(new_offset, blocked);
         }
     }
@@ -240,8 +271,11 @@ void ClauseAllocator::move_one_watchlist(
 
 Firstly, the algorithm determines if the number of useless slots is large or
 small compared to the problem size. If it is small, it does nothing. If it is
-large, then it allocates new stacks, copies the non-freed clauses to these new
-stacks, updates all pointers and offsets, and frees the original stacks.
+large, it first tries to only slide down the clauses above the first sparse
+region, in-place (see consolidate_tail()). If the stack is sparse all over, or
+if forced, it allocates a new stack, copies the non-freed clauses to it in the
+order they are watched, grouped by irredundant/redundant tier, updates all
+pointers and offsets, and frees the original stack.
 */
 void ClauseAllocator::consolidate(
     Solver* solver
@@ -261,22 +295,51 @@ void ClauseAllocator::consolidate(
         return;
     }
     const double my_time = cpu_time();
+    const uint64_t old_size = size;
+    uint64_t moved = 0;
+    if (!force && consolidate_tail(solver, moved)) {
+        print_consolidate_stats(solver, "consolidate-tail", old_size, moved, my_time, lower_verb);
+        return;
+    }
     new_sz_while_moving = 0;
 
+    //Exact size of each region of the new stack: irredundant, then the
+    //redundant tiers in order
+    vector<uint64_t> region_sz(1 + solver->longRedCls.size(), 0);
+    for(const ClOffset offs: solver->longIrredCls) {
+        const Clause* cl = ptr(offs);
+        region_sz[cl_region(cl)] += clause_storage_elems(cl->size());
+    }
+    for(const auto& lredcls: solver->longRedCls) {
+        for(const ClOffset offs: lredcls) {
+            const Clause* cl = ptr(offs);
+            region_sz[cl_region(cl)] += clause_storage_elems(cl->size());
+        }
+    }
+    uint64_t total = 0;
+    for(const uint64_t sz: region_sz) total += sz;
+
     //Pointers that will be moved along
-    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(currentlyUsedSize*sizeof(BASE_DATA_TYPE));
-    BASE_DATA_TYPE * new_ptr = newDataStart;
+    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(std::max<uint64_t>(total, 1)*sizeof(BASE_DATA_TYPE));
+    vector<BASE_DATA_TYPE*> new_ptrs(region_sz.size());
+    BASE_DATA_TYPE* at = newDataStart;
+    for(size_t i = 0; i < region_sz.size(); i++) {
+        new_ptrs[i] = at;
+        at += region_sz[i];
+    }
 
     assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
 
     for(auto& ws: solver->watches) {
-        move_one_watchlist(ws, newDataStart, new_ptr);
+        move_one_watchlist(ws, newDataStart, new_ptrs);
     }
 
-    update_offsets(solver->longIrredCls, newDataStart, new_ptr);
+    update_offsets(solver->longIrredCls, newDataStart, new_ptrs);
     for(auto& lredcls: solver->longRedCls) {
-        update_offsets(lredcls, newDataStart, new_ptr);
+        update_offsets(lredcls, newDataStart, new_ptrs);
     }
+    assert(new_sz_while_moving == total);
+    assert(new_ptrs.back() == newDataStart + total);
 
     //Fix up propBy
     for (size_t i = 0; i < solver->nVars(); i++) {
@@ -297,13 +360,129 @@ void ClauseAllocator::consolidate(
     }
 
     //Update sizes
-    const uint64_t old_size = size;
-    size = new_ptr-newDataStart;
-    capacity = currentlyUsedSize;
+    size = total;
+    capacity = std::max<uint64_t>(total, 1);
     currentlyUsedSize = new_sz_while_moving;
     free(dataStart);
     dataStart = newDataStart;
+    print_consolidate_stats(solver, "consolidate", old_size, total, my_time, lower_verb);
+}
+
+/**
+@brief Slides the clauses above the first sparse region down, in-place
+
+The stack is looked at in CONSOLIDATE_REGION_SIZE pieces. Everything below the
+first one that is less than 80% used stays where it is, and no second stack is
+needed. Only the clauses that move are sorted and copied, and old offsets are
+mapped to new ones through that sorted list, as the old clauses get
+overwritten while moving. Finding them, and fixing up the watches, still takes
+one linear pass over the clause lists and all watch lists, but offsets below
+the moved part are left alone without a lookup.
 
+Returns false if the very first region is sparse, and nothing was done.
+*/
+bool ClauseAllocator::consolidate_tail(Solver* solver, uint64_t& moved)
+{
+    const uint64_t num_regions = size/CONSOLIDATE_REGION_SIZE + 1;
+    vector<uint64_t> region_used(num_regions, 0);
+    uint64_t total = 0;
+    const auto count_used = [&](const vector<ClOffset>& offsets) {
+        for(const ClOffset offs: offsets) {
+            const uint64_t sz = clause_storage_elems(ptr(offs)->size());
+            region_used[offs/CONSOLIDATE_REGION_SIZE] += sz;
+            total += sz;
+        }
+    };
+    count_used(solver->longIrredCls);
+    for(const auto& lredcls: solver->longRedCls) count_used(lredcls);
+
+    uint64_t first_sparse = 0;
+    for(; first_sparse < num_regions; first_sparse++) {
+        const uint64_t region_start = first_sparse*CONSOLIDATE_REGION_SIZE;
+        const uint64_t region_sz = std::min<uint64_t>(size - region_start, CONSOLIDATE_REGION_SIZE);
+        if (float_div(region_used[first_sparse], region_sz) < 0.8) break;
+    }
+    if (first_sparse == 0) return false;
+
+    //Clauses at and above "cutoff" get moved, right after the last one that
+    //is not
+    const uint64_t cutoff = first_sparse*CONSOLIDATE_REGION_SIZE;
+    vector<ClOffset> old_offs;
+    uint64_t new_at = 0;
+    const auto collect = [&](const vector<ClOffset>& offsets) {
+        for(const ClOffset offs: offsets) {
+            if (offs >= cutoff) {
+                old_offs.push_back(offs);
+            } else {
+                new_at = std::max<uint64_t>(
+                    new_at, offs + clause_storage_elems(ptr(offs)->size()));
+            }
+        }
+    };
+    collect(solver->longIrredCls);
+    for(const auto& lredcls: solver->longRedCls) collect(lredcls);
+    std::sort(old_offs.begin(), old_offs.end());
+
+    vector<ClOffset> new_offs(old_offs.size());
+    for(size_t i = 0; i < old_offs.size(); i++) {
+        assert(i == 0 || old_offs[i-1] < old_offs[i]);
+        const uint64_t sz = clause_storage_elems(ptr(old_offs[i])->size());
+        assert(new_at <= old_offs[i]);
+        memmove(dataStart + new_at, dataStart + old_offs[i], sz*sizeof(BASE_DATA_TYPE));
+        new_offs[i] = new_at;
+        new_at += sz;
+    }
+    moved = new_at - (old_offs.empty() ? new_at : new_offs[0]);
+
+    const ClOffset first_moved = old_offs.empty() ? size : old_offs[0];
+    const auto remap = [&](const ClOffset offs) -> ClOffset {
+        if (offs < first_moved) return offs;
+        const auto it = std::lower_bound(old_offs.begin(), old_offs.end(), offs);
+        assert(it != old_offs.end() && *it == offs);
+        return new_offs[it - old_offs.begin()];
+    };
+
+    for(auto& ws: solver->watches) {
+        for(Watched& w: ws) {
+            if (w.isClause() && w.get_offset() >= first_moved) {
+                w = Watched(remap(w.get_offset()), w.getBlockedLit());
+            }
+        }
+    }
+    for(ClOffset& offs: solver->longIrredCls) offs = remap(offs);
+    for(auto& lredcls: solver->longRedCls) {
+        for(ClOffset& offs: lredcls) offs = remap(offs);
+    }
+
+    //Fix up propBy
+    for (size_t i = 0; i < solver->nVars(); i++) {
+        VarData& vdata = solver->varData[i];
+        if (vdata.reason.isClause()) {
+            if (vdata.removed == Removed::none
+                && solver->decisionLevel() >= vdata.level
+                && vdata.level != 0
+                && solver->value(i) != l_Undef
+            ) {
+                vdata.reason = PropBy(remap(vdata.reason.get_offset()));
+            } else {
+                vdata.reason = PropBy();
+            }
+        }
+    }
+
+    size = new_at;
+    currentlyUsedSize = total;
+    return true;
+}
+
+void ClauseAllocator::print_consolidate_stats(
+    Solver* solver
+    , const char* name
+    , const uint64_t old_size
+    , const uint64_t moved
+    , const double my_time
+    , const bool lower_verb
+) const {
     const double time_used = cpu_time() - my_time;
     if (solver->conf.verbosity >= 2
         || (lower_verb && solver->conf.verbosity)
@@ -313,9 +492,10 @@ void ClauseAllocator::consolidate(
             //yes, it can be 0 (only binary clauses, for example)
             log_2_size = std::log2(size);
         }
-        cout << solver->conf.prefix << "[mem] consolidate ";
+        cout << solver->conf.prefix << "[mem] " << name << " ";
         cout << " old-sz: " << print_value_kilo_mega(old_size*sizeof(BASE_DATA_TYPE))
         << " new-sz: " << print_value_kilo_mega(size*sizeof(BASE_DATA_TYPE))
+        << " moved: " << print_value_kilo_mega(moved*sizeof(BASE_DATA_TYPE))
         << " new bits offs: " << std::fixed << std::setprecision(2) << log_2_size;
         cout << solver->conf.print_times(time_used)
         << endl;
@@ -323,7 +503,7 @@ void ClauseAllocator::consolidate(
     if (solver->sqlStats) {
         solver->sqlStats->time_passed_min(
             solver
-            , "consolidate"
+            , name
             , time_used
         );
     }
@@ -332,14 +512,14 @@ void ClauseAllocator::consolidate(
 void ClauseAllocator::update_offsets(
     vector<ClOffset>& offsets,
     ClOffset* newDataStart,
-    ClOffset*& new_ptr
+    vector<ClOffset*>& new_ptrs
 ) {
 
     for(ClOffset& offs: offsets) {
         Clause* old = ptr(offs);
         offs = old->reloced
             ? read_reloced_offset(old)
-            : move_cl(newDataStart, new_ptr, old);
+            : move_cl(newDataStart, new_ptrs, old);
     }
 }
 
@@ -48,7 +48,10 @@ using std::vector;
 
 This class allocates memory in large chunks, then distributes it to clauses when
 needed. When instructed, it consolidates the unused space (i.e. clauses free()-ed).
-Essentially, it is a stack-like allocator for clauses. It is useful to have
+A full consolidation lays out the irredundant clauses first, then the redundant
+ones tier by tier, so the churn of reduceDB concentrates at the end of the
+stack. Later consolidations then only slide down what is above the first
+sparse region, in-place. Essentially, it is a stack-like allocator for clauses. It is useful to have
 this, because this way, we can address clauses according to their number,
 which is 32-bit, instead of their address, which might be 64-bit
 */
@@ -60,14 +63,14 @@ class ClauseAllocator {
         ClauseAllocator& operator=(const ClauseAllocator&) = delete;
 
         template<class T>
-        Clause* Clause_new(const T& ps, const uint32_t conflictNum, const uint32_t ID)
+        Clause* Clause_new(const T& ps, const uint32_t ID)
         {
             if (ps.size() > (0x01UL << 28)) {
                 throw CMSat::TooLongClauseError();
             }
 
             void* mem = allocEnough(ps.size());
-            Clause* real = new (mem) Clause(ps, conflictNum, ID);
+            Clause* real = new (mem) Clause(ps, ID);
             return real;
         }
 
@@ -88,21 +91,31 @@ class ClauseAllocator {
         );
 
         size_t mem_used() const;
+        void reserve(const uint64_t num_cls, const uint64_t num_lits);
 
     private:
         void update_offsets(
             vector<ClOffset>& offsets,
             ClOffset* newDataStart,
-            ClOffset*& new_ptr
+            vector<ClOffset*>& new_ptrs
         );
         void move_one_watchlist(
-            watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr);
+            watch_subarray& ws, ClOffset* newDataStart, vector<ClOffset*>& new_ptrs);
 
         ClOffset move_cl(
             ClOffset* newDataStart
-            , ClOffset*& new_ptr
+            , vector<ClOffset*>& new_ptrs
             , Clause* old
         );
+        bool consolidate_tail(Solver* solver, uint64_t& moved);
+        void print_consolidate_stats(
+            Solver* solver
+            , const char* name
+            , const uint64_t old_size
+            , const uint64_t moved
+            , const double my_time
+            , const bool lower_verb
+        ) const;
 
         uint32_t new_sz_while_moving = 0;
         BASE_DATA_TYPE* dataStart = nullptr; ///<Stack starts at these positions
@@ -124,6 +137,7 @@ class ClauseAllocator {
         uint64_t currentlyUsedSize = 0;
 
         void* allocEnough(const uint32_t num_lits);
+        void grow(const uint64_t needed);
 };
 
 } //end namespace
@@ -92,19 +92,22 @@ BreakID::add_cl_ret BreakID::add_this_clause(const T& cl)
     return add_cl_ret::added_cl;
 }
 
+typedef std::pair<uint32_t, ClOffset> HashedCl;
+
 struct EqCls {
     EqCls(ClauseAllocator& _alloc) :
         cl_alloc(_alloc)
     {}
 
-    bool operator()(ClOffset off1, ClOffset off2) {
-        Clause* cl1 = cl_alloc.ptr(off1);
-        Clause* cl2 = cl_alloc.ptr(off2);
-
-        if (cl1->stats.hash_val != cl2->stats.hash_val) {
-            return cl1->stats.hash_val < cl2->stats.hash_val;
+    //Pairs of (hash, clause offset)
+    bool operator()(const HashedCl& a, const HashedCl& b) {
+        if (a.first != b.first) {
+            return a.first < b.first;
         }
 
+        Clause* cl1 = cl_alloc.ptr(a.second);
+        Clause* cl2 = cl_alloc.ptr(b.second);
+
         if (cl1->size() != cl2->size()) {
             return cl1->size() < cl2->size();
         }
@@ -123,11 +126,14 @@ struct EqCls {
     ClauseAllocator& cl_alloc;
 };
 
-static bool equiv(Clause* cl1, Clause* cl2) {
-    if (cl1->stats.hash_val != cl2->stats.hash_val) {
+static bool equiv(const HashedCl& a, const HashedCl& b, ClauseAllocator& cl_alloc) {
+    if (a.first != b.first) {
         return false;
     }
 
+    Clause* cl1 = cl_alloc.ptr(a.second);
+    Clause* cl2 = cl_alloc.ptr(b.second);
+
     if (cl1->size() != cl2->size()) {
         return false;
     }
@@ -343,6 +349,7 @@ void BreakID::remove_duplicates()
 {
     double my_time = cpu_time();
     dedup_cls.clear();
+    vector<HashedCl> hashed_cls;
 
     for(ClOffset offs: solver->longIrredCls) {
         Clause* cl = solver->cl_alloc.ptr(offs);
@@ -350,28 +357,17 @@ void BreakID::remove_duplicates()
         assert(!cl->get_removed());
         assert(!cl->red());
         std::sort(cl->begin(), cl->end());
-        cl->stats.hash_val = hash_clause(cl->getData(), cl->size());
-        dedup_cls.push_back(offs);
-    }
-
-    std::sort(dedup_cls.begin(), dedup_cls.end(), EqCls(solver->cl_alloc));
-
-    size_t old_size = dedup_cls.size();
-    if (dedup_cls.size() > 1 && true) {
-        auto prev = dedup_cls.begin();
-        auto i = dedup_cls.begin();
-        ++i;
-        Clause* prevcl = solver->cl_alloc.ptr(*prev);
-        for (auto end = dedup_cls.end(); i != end; ++i) {
-            Clause* cl = solver->cl_alloc.ptr(*i);
-            if (!equiv(cl, prevcl)) {
-                ++prev;
-                *prev = *i;
-                prevcl = cl;
-            }
+        hashed_cls.push_back(std::make_pair(hash_clause(cl->getData(), cl->size()), offs));
+    }
+
+    std::sort(hashed_cls.begin(), hashed_cls.end(), EqCls(solver->cl_alloc));
+
+    size_t old_size = hashed_cls.size();
+    for(size_t i = 0; i < hashed_cls.size(); i++) {
+        if (i > 0 && equiv(hashed_cls[i], hashed_cls[i-1], solver->cl_alloc)) {
+            continue;
         }
-        ++prev;
-        dedup_cls.resize(prev-dedup_cls.begin());
+        dedup_cls.push_back(hashed_cls[i].second);
     }
 
     double time_used = cpu_time() - my_time;
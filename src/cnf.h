@@ -142,9 +142,7 @@ public:
     **/
     vector<vector<ClOffset> > longRedCls;
     vector<uint64_t> longRedClsSizes;
-    #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
-    vector<ClauseStatsExtra> red_stats_extra;
-    #endif
+    vector<ClauseStatsExtra> red_stats_extra; //see ClauseStats::extra_pos
 
     // xorclauses -- current, attached XORs. Some XORs may be XOR'ed together
     //               however, they are never in a matrix.
@@ -190,6 +188,7 @@ public:
     void set_must_interrupt_asap() { must_interrupt_inter->store(true, std::memory_order_relaxed); }
     void unset_must_interrupt_asap() { must_interrupt_inter->store(false, std::memory_order_relaxed); }
     std::atomic<bool>* get_must_interrupt_inter_asap_ptr() { return must_interrupt_inter; }
+    void set_must_interrupt_inter_asap_ptr(std::atomic<bool>* p) { must_interrupt_inter = p; }
     const vector<BNN*>& get_bnns() const { return bnns; }
 
     bool check_bnn_sane(BNN& bnn);
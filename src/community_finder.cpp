@@ -26,14 +26,8 @@ THE SOFTWARE.
 #include "occsimplifier.h"
 #include "clauseallocator.h"
 #include "sqlstats.h"
+#include "louvain.h"
 #include <limits>
-#include <map>
-#include <utility>
-#include <louvain_communities/louvain_communities.h>
-
-using std::map;
-using std::pair;
-using std::make_pair;
 
 using namespace CMSat;
 
@@ -49,56 +43,66 @@ void CMSat::CommunityFinder::compute()
         v.community_num = numeric_limits<uint32_t>::max();
     }
 
-    //Check for too large
-    if (solver->nVars() > 300ULL*1000ULL) {
-        return;
-    }
-
     double my_time = cpu_time();
-    map<pair<uint32_t, uint32_t>, long double> edges;
 
-    //VIG-graph edge weight: each clause of length n contributes
+    //VIG-graph. A clause of length n is a clique with total weight 1, i.e.
     //  1 / (n*(n-1)/2) to every pair of vars it contains
-    auto vig_weight = [](uint32_t size) {
-        return 1.0L / ((long double)size * ((long double)size - 1.0L) / 2.0L);
-    };
-    auto add_edge = [&](uint32_t v1, uint32_t v2, long double weight) {
-        if (v2 < v1) std::swap(v1, v2);
-        edges[make_pair(v1, v2)] += weight;
-    };
+    //Above max_clique_size that is too many edges, so the clause becomes a
+    //cycle through its variables instead, with 1/n on each edge. Same total
+    //weight, and the variables still end up connected
+    uint64_t num_edges = 0;
+    for(const auto& offs: solver->longIrredCls) {
+        const uint64_t sz = solver->cl_alloc.ptr(offs)->size();
+        num_edges += sz <= max_clique_size ? sz*(sz-1)/2 : sz;
+    }
+    num_edges += solver->binTri.irredBins;
+    if (num_edges > max_edges) {
+        verb_print(1, "[louvain] too many edges in VIG (" << num_edges
+            << "), skipping community detection");
+        return;
+    }
+
+    vector<Louvain::Edge> edges;
+    edges.reserve(num_edges);
 
     //Binary clauses
     for(uint32_t watched_at = 0; watched_at < solver->nVars()*2; watched_at++) {
         const Lit l = Lit::toLit(watched_at);
         for (const Watched& w: solver->watches[l]) {
             if (w.isBin() && w.lit2() < l && !w.red()) {
-                add_edge(l.var(), w.lit2().var(), vig_weight(2));
+                edges.push_back({l.var(), w.lit2().var(), 1.0f});
             }
         }
     }
 
     //Non-binary clauses
     for(const auto& offs: solver->longIrredCls) {
-        const Clause* cl = solver->cl_alloc.ptr(offs);
-        const long double weight = vig_weight(cl->size());
-        for(uint32_t i = 0; i < cl->size(); i++) {
-            for(uint32_t i2 = i+1; i2 < cl->size(); i2++) {
-                add_edge((*cl)[i].var(), (*cl)[i2].var(), weight);
+        const Clause& cl = *solver->cl_alloc.ptr(offs);
+        const uint32_t sz = cl.size();
+        if (sz <= max_clique_size) {
+            const float weight = 2.0/((double)sz*(double)(sz-1));
+            for(uint32_t i = 0; i < sz; i++) {
+                for(uint32_t i2 = i+1; i2 < sz; i2++) {
+                    edges.push_back({cl[i].var(), cl[i2].var(), weight});
+                }
+            }
+        } else {
+            const float weight = 1.0/(double)sz;
+            for(uint32_t i = 0; i < sz; i++) {
+                edges.push_back({cl[i].var(), cl[(i+1)%sz].var(), weight});
             }
         }
     }
-
-    LouvainC::Communities graph;
-    for(const auto& it: edges) {
-        graph.add_edge(it.first.first, it.first.second, it.second);
-    }
-    graph.calculate(true);
-    auto mapping = graph.get_mapping();
-
-    for(const auto& x: mapping) {
-        assert(x.first < solver->nVars());
-        assert(x.second < solver->nVars());
-        solver->varData[x.first].community_num = x.second;
+    const size_t edges_added = edges.size();
+
+    Louvain louvain(solver->nVars(), edges);
+    const vector<uint32_t> mapping = louvain.compute();
+    assert(mapping.size() == solver->nVars());
+    uint32_t num_comms = 0;
+    for(uint32_t v = 0; v < solver->nVars(); v++) {
+        assert(mapping[v] < solver->nVars());
+        solver->varData[v].community_num = mapping[v];
+        num_comms = std::max(num_comms, mapping[v]+1);
     }
 
     //Recompute connects_num_communities for all redundant clauses
@@ -113,8 +117,12 @@ void CMSat::CommunityFinder::compute()
 
     double time_passed = cpu_time() - my_time;
     if (solver->conf.verbosity) {
-        cout << "c [louvain] Louvain communities found. T: "
-        << std::fixed << std::setprecision(2)
+        cout << "c [louvain] Louvain communities found."
+        << " comms: " << num_comms
+        << " levels: " << louvain.num_levels()
+        << " Q: " << std::fixed << std::setprecision(3) << louvain.modularity()
+        << " edges: " << edges_added
+        << " T: " << std::setprecision(2)
         << solver->conf.print_times(time_passed) << endl;
     }
 
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #ifndef COMMUNITY_FINDER_H__
 #define COMMUNITY_FINDER_H__
 
+#include <cstdint>
 #include <vector>
 using std::vector;
 
@@ -39,6 +40,11 @@ public:
 private:
     Solver* solver;
 
+    ///Clauses longer than this are added to the VIG as a cycle, not a clique
+    static constexpr uint32_t max_clique_size = 20;
+    ///Beyond this many VIG edges (about 12 bytes each) don't even try
+    static constexpr uint64_t max_edges = 200ULL*1000ULL*1000ULL;
+
 };
 
 }
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "solver.h"
 #include "frat.h"
 #include "shareddata.h"
+#include "datasync.h"
 #include "solvertypesmini.h"
 
 #include <fstream>
@@ -32,6 +33,9 @@ THE SOFTWARE.
 #include <iomanip>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
 #include <atomic>
 #include <cassert>
 using std::thread;
@@ -135,6 +139,10 @@ struct DataForThread
     std::mutex* update_mutex;
     int *which_solved;
     lbool* ret;
+
+    //Size hints for bulk-adding lits_to_add
+    uint64_t num_long_cls = 0;
+    uint64_t num_long_lits = 0;
 };
 
 DLL_PUBLIC SATSolver::SATSolver(
@@ -399,12 +407,6 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
         throw std::runtime_error(err);
     }
 
-    if (data->solvers[0]->frat->enabled()) {
-        const char err[] = "ERROR: FRAT cannot be used in multi-threaded mode";
-        std::cerr << err << endl;
-        throw std::runtime_error(err);
-    }
-
     if (data->cls > 0 || nVars() > 0) {
         const char err[] = "ERROR: You must first call set_num_threads() and only then add clauses and variables";
         std::cerr << err << endl;
@@ -437,6 +439,9 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
         data->solvers[i]->setConf(conf);
         data->solvers[i]->set_shared_data((SharedData*)data->shared_data);
     }
+
+    FILE* fratf = data->solvers[0]->frat->getFile();
+    if (fratf) set_frat(fratf);
 }
 
 struct OneThreadAddCls
@@ -449,6 +454,8 @@ struct OneThreadAddCls
     void operator()() {
         Solver& solver = *data_for_thread.solvers[tid];
         solver.new_external_vars(data_for_thread.vars_to_add);
+        solver.reserve_long_irred_cls(
+            data_for_thread.num_long_cls, data_for_thread.num_long_lits);
 
         vector<Lit> lits;
         bool ret = true;
@@ -466,7 +473,8 @@ struct OneThreadAddCls
                 ) {
                     lits.push_back(orig_lits[at]);
                 }
-                ret = solver.add_clause_outside(lits);
+                if (solver.frat->enabled()) ret = solver.add_clause_outside(lits);
+                else ret = solver.add_clause_outside_bulk(lits);
             } else {
                 lits.clear();
                 at++;
@@ -494,10 +502,67 @@ struct OneThreadAddCls
     const size_t tid;
 };
 
+//Sorts and removes duplicate literals from the cached clauses in-place, so
+//this is done once, not once per thread. Tautologies are left alone, the
+//solvers must see them to know which variables they need to set.
+//XOR clauses are not touched. Also counts the long clauses for pre-sizing.
+static void sort_and_dedup_cls_lits(
+    vector<Lit>& buf
+    , uint64_t& num_long_cls
+    , uint64_t& num_long_lits
+) {
+    const size_t size = buf.size();
+    size_t at = 0;
+    size_t j = 0;
+    while(at < size) {
+        if (buf[at] == lit_Error) {
+            buf[j++] = buf[at++]; //marker
+            buf[j++] = buf[at++]; //rhs
+            for(; at < size && buf[at] != lit_Undef && buf[at] != lit_Error; at++) {
+                buf[j++] = buf[at];
+            }
+            continue;
+        }
+
+        assert(buf[at] == lit_Undef);
+        buf[j++] = buf[at++];
+        const size_t start = at;
+        for(; at < size && buf[at] != lit_Undef && buf[at] != lit_Error; at++) {}
+        std::sort(buf.begin() + start, buf.begin() + at);
+
+        bool taut = false;
+        for(size_t i = start+1; i < at; i++) {
+            if (buf[i] == ~buf[i-1]) {
+                taut = true;
+                break;
+            }
+        }
+
+        const size_t cl_start = j;
+        for(size_t i = start; i < at; i++) {
+            if (!taut && j > cl_start && buf[j-1] == buf[i]) continue;
+            buf[j++] = buf[i];
+        }
+        if (j - cl_start > 2) {
+            num_long_cls++;
+            num_long_lits += j - cl_start;
+        }
+    }
+    buf.resize(j);
+}
+
 //Add the cached clauses and variables to the threads
 static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
 {
     DataForThread data_for_thread(data);
+    //FRAT must see the original clauses
+    if (data->solvers.size() > 1 && !data->solvers[0]->frat->enabled()) {
+        sort_and_dedup_cls_lits(
+            data->cls_lits
+            , data_for_thread.num_long_cls
+            , data_for_thread.num_long_lits);
+    }
+
     if (data->solvers.size() == 1) {
         OneThreadAddCls t(data_for_thread, 0);
         t.operator()();
@@ -902,6 +967,346 @@ struct OneThreadCalc
     bool only_sampling_solution;
 };
 
+//Cube-and-conquer: the cubes still to be solved, one deque per thread. Each
+//thread works depth-first from the back of its own deque, idle threads steal
+//from the front of the fullest one, where the shortest cubes are. Every
+//thread solves with its own interrupt flag, so a finished cube doesn't stop
+//the others.
+struct CubeQueue
+{
+    explicit CubeQueue(size_t num_threads) :
+        cubes(num_threads)
+        , interrupt(num_threads)
+    {
+        for(auto& i: interrupt) i.store(false, std::memory_order_relaxed);
+    }
+
+    bool get_cube(const size_t tid, vector<Lit>& cube, const std::atomic<bool>& user_interrupt)
+    {
+        std::unique_lock<std::mutex> lock(mu);
+        while(true) {
+            if (!stop && user_interrupt.load(std::memory_order_relaxed)) {
+                finish(l_Undef, tid);
+            }
+            if (stop) return false;
+
+            size_t from = tid;
+            if (cubes[tid].empty()) {
+                for(size_t i = 0; i < cubes.size(); i++) {
+                    if (cubes[i].size() > cubes[from].size()) from = i;
+                }
+            }
+            if (!cubes[from].empty()) {
+                if (from == tid) {
+                    cube = std::move(cubes[tid].back());
+                    cubes[tid].pop_back();
+                } else {
+                    cube = std::move(cubes[from].front());
+                    cubes[from].pop_front();
+                    stolen++;
+                }
+                interrupt[tid].store(false, std::memory_order_relaxed);
+                return true;
+            }
+
+            //Nothing to do right now, but cubes being solved may get split
+            assert(pending > 0);
+            cv.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    //Solve the cube we have again, unless we must stop
+    bool resume(const size_t tid)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (stop) return false;
+        interrupt[tid].store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool stopped()
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        return stop;
+    }
+
+    void refuted(const size_t tid)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        assert(pending > 0);
+        pending--;
+        num_refuted++;
+        if (pending == 0 && !stop) {
+            all_refuted = true;
+            finish(l_False, tid);
+        }
+    }
+
+    void split(const size_t tid, vector<Lit>& cube, const Lit l)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        pending++;
+        num_split++;
+        cube.push_back(~l);
+        cubes[tid].push_back(cube);
+        cube.back() = l;
+        cubes[tid].push_back(cube);
+        cv.notify_all();
+    }
+
+    void solved(const lbool _ret, const size_t tid)
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!stop) finish(_ret, tid);
+    }
+
+    void exited()
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        assert(running > 0);
+        running--;
+        cv.notify_all();
+    }
+
+    //Forwards the user's interrupt to the workers until all of them exited.
+    //They solve with their own flags, so they would not see it otherwise.
+    void watch_user_interrupt(const std::atomic<bool>& user_interrupt)
+    {
+        std::unique_lock<std::mutex> lock(mu);
+        while(running > 0) {
+            if (!stop && user_interrupt.load(std::memory_order_relaxed)) {
+                finish(l_Undef, 0);
+            }
+            cv.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    std::mutex mu;
+    std::condition_variable cv;
+    vector<std::deque<vector<Lit>>> cubes;
+    vector<std::atomic<bool>> interrupt;
+    uint64_t pending = 0; //queued or being solved
+    size_t running = 0; //worker threads that haven't exited yet
+    bool stop = false;
+    bool all_refuted = false;
+    lbool ret = l_Undef;
+    size_t which_solved = 0;
+
+    //stats
+    uint64_t num_refuted = 0;
+    uint64_t num_split = 0;
+    uint64_t stolen = 0;
+
+private:
+    //Must hold "mu"
+    void finish(const lbool _ret, const size_t tid)
+    {
+        stop = true;
+        ret = _ret;
+        which_solved = tid;
+        for(auto& i: interrupt) i.store(true, std::memory_order_relaxed);
+        cv.notify_all();
+    }
+};
+
+struct OneThreadCube
+{
+    OneThreadCube(
+        DataForThread& _data_for_thread,
+        CubeQueue& _queue,
+        size_t _tid,
+        bool _only_sampling_solution
+    ) :
+        data_for_thread(_data_for_thread)
+        , queue(_queue)
+        , tid(_tid)
+        , only_sampling_solution(_only_sampling_solution)
+    {
+        assert(data_for_thread.solvers.size() > tid);
+    }
+
+    void operator()()
+    {
+        Solver& s = *data_for_thread.solvers[tid];
+        std::atomic<bool>* user_interrupt = s.get_must_interrupt_inter_asap_ptr();
+        s.set_must_interrupt_inter_asap_ptr(&queue.interrupt[tid]);
+
+        //These are reset by every solve() call
+        const uint64_t max_confl = s.conf.max_confl;
+        const double max_time = s.conf.maxTime;
+
+        vector<Lit> cube;
+        bool unlimited = false;
+        while(unlimited ? queue.resume(tid) : queue.get_cube(tid, cube, *user_interrupt)) {
+            if (cube.size() >= s.conf.cube_max_len) unlimited = true;
+            if (!unlimited) s.set_max_confl(s.conf.cube_confl_budget);
+            s.conf.max_confl = std::min(s.conf.max_confl, max_confl);
+            s.conf.maxTime = max_time;
+            const lbool ret = s.solve_with_assumptions(&cube, only_sampling_solution);
+            unlimited = false;
+
+            if (ret == l_True || (ret == l_False && !s.okay())) {
+                queue.solved(ret, tid);
+                break;
+            }
+
+            if (ret == l_False) {
+                //Keep what the conflict taught us, it's implied
+                if (!s.add_clause_outside(s.get_final_conflict(), true)) {
+                    queue.solved(l_False, tid);
+                    break;
+                }
+                queue.refuted(tid);
+                continue;
+            }
+
+            assert(ret == l_Undef);
+            //Someone else finished
+            if (queue.stopped()) break;
+            if (user_interrupt->load(std::memory_order_relaxed)
+                || s.get_stats().conflicts >= max_confl
+                || cpu_time() > max_time
+            ) {
+                queue.solved(l_Undef, tid);
+                break;
+            }
+
+            //Out of budget, split it
+            const Lit l = s.lookahead_split_lit(cube);
+            if (l == lit_Error) {
+                if (!s.okay()) {
+                    queue.solved(l_False, tid);
+                    break;
+                }
+                queue.refuted(tid);
+            } else if (l == lit_Undef) {
+                unlimited = true;
+            } else {
+                queue.split(tid, cube, l);
+            }
+        }
+
+        s.set_must_interrupt_inter_asap_ptr(user_interrupt);
+        data_for_thread.cpu_times[tid] = cpu_time();
+        queue.exited();
+    }
+
+    DataForThread& data_for_thread;
+    CubeQueue& queue;
+    const size_t tid;
+    bool only_sampling_solution;
+};
+
+//Creates the initial cubes by breadth-first lookahead splitting on "s"
+static void create_initial_cubes(Solver& s, CubeQueue& queue)
+{
+    const size_t num_threads = queue.cubes.size();
+    const size_t want = num_threads * s.conf.cube_init_per_thread;
+    std::deque<vector<Lit>> todo;
+    todo.push_back(vector<Lit>());
+    while(!todo.empty() && todo.size() < want) {
+        vector<Lit> cube = std::move(todo.front());
+        todo.pop_front();
+        const Lit l = (cube.size() >= s.conf.cube_max_len) ?
+            lit_Undef : s.lookahead_split_lit(cube);
+        if (l == lit_Error) {
+            //Refuted, unless the whole problem is UNSAT. Either way, nothing
+            //to do for this cube.
+            if (!s.okay()) todo.clear();
+            continue;
+        }
+        if (l == lit_Undef) {
+            todo.push_front(cube);
+            break;
+        }
+        cube.push_back(l);
+        todo.push_back(cube);
+        cube.back() = ~l;
+        todo.push_back(cube);
+    }
+
+    if (s.conf.verbosity) {
+        cout << "c [cube] initial cubes: " << todo.size()
+        << " threads: " << num_threads << endl;
+    }
+
+    //An empty queue means UNSAT, the caller handles it
+    queue.pending = todo.size();
+    for(size_t i = 0; i < todo.size(); i++) {
+        queue.cubes[i % num_threads].push_back(std::move(todo[i]));
+    }
+}
+
+static lbool calc_cube_and_conquer(
+    CMSatPrivateData *data,
+    bool only_sampling_solution
+) {
+    if (!actually_add_clauses_to_threads(data)) {
+        data->which_solved = 0;
+        data->okay = data->solvers[0]->okay();
+        return l_False;
+    }
+
+    DataForThread data_for_thread(data);
+    CubeQueue queue(data->solvers.size());
+    Solver& s0 = *data->solvers[0];
+    const double start_time = cpu_time();
+    create_initial_cubes(s0, queue);
+
+    if (queue.pending == 0) {
+        queue.all_refuted = true;
+        queue.ret = l_False;
+    } else {
+        vector<thread> thds;
+        queue.running = data->solvers.size();
+        for(size_t i = 0 ; i < data->solvers.size() ; i++) {
+            thds.push_back(thread(OneThreadCube(data_for_thread, queue, i, only_sampling_solution)));
+        }
+        queue.watch_user_interrupt(*data->must_interrupt);
+        for(std::thread& t: thds){
+            t.join();
+        }
+    }
+
+    if (s0.conf.verbosity) {
+        cout << "c [cube] result: " << queue.ret
+        << " refuted: " << queue.num_refuted
+        << " split: " << queue.num_split
+        << " stolen: " << queue.stolen
+        << " T: " << std::fixed << std::setprecision(2) << (cpu_time() - start_time)
+        << endl;
+    }
+
+    data->which_solved = queue.which_solved;
+    Solver& s = *data->solvers[queue.which_solved];
+    lbool ret = queue.ret;
+    if (queue.all_refuted) {
+        //Every cube is refuted, so the problem is UNSAT. Let the solver we
+        //report know, so its state and final conflict are consistent.
+        vector<Lit> empty;
+        s.add_clause_outside(empty);
+        ret = s.solve_with_assumptions(nullptr, only_sampling_solution);
+        assert(ret == l_False);
+    }
+
+    s.unset_must_interrupt_asap();
+    data->okay = s.okay();
+    return ret;
+}
+
+//All threads write into the same FRAT file. The copies of the clauses they
+//shared can only be finalized once nobody can import them anymore, and after
+//everything the importers wrote
+static void finalize_frat_shared(CMSatPrivateData* data)
+{
+    if (!data->solvers[0]->frat->enabled()) return;
+    for(Solver* s: data->solvers) s->frat->flush();
+    for(Solver* s: data->solvers) {
+        s->datasync->finalize_frat_shared();
+        s->frat->flush();
+    }
+}
+
 lbool calc(
     const vector< Lit >* assumptions,
     Todo todo,
@@ -964,6 +1369,14 @@ lbool calc(
     }
 
     //Multi-threaded case
+    if (todo == Todo::todo_solve
+        && data->solvers[0]->conf.cube_and_conquer
+        && !data->solvers[0]->frat->enabled()
+        && (assumptions == nullptr || assumptions->empty())
+    ) {
+        return calc_cube_and_conquer(data, only_sampling_solution);
+    }
+
     DataForThread data_for_thread(data, assumptions);
     vector<thread> thds;
     for(size_t i = 0 ; i < data->solvers.size() ; i++) {
@@ -977,6 +1390,7 @@ lbool calc(
 
     //This does it for all of them, there is only one must-interrupt
     data_for_thread.solvers[0]->unset_must_interrupt_asap();
+    finalize_frat_shared(data);
 
     //clear what has been added
     data->cls_lits.clear();
@@ -1137,18 +1551,19 @@ DLL_PUBLIC void SATSolver::set_find_xors(bool do_find_xors)
 
 DLL_PUBLIC void SATSolver::set_frat(FILE* os)
 {
-    if (data->solvers.size() > 1) {
-        std::cerr << "ERROR: FRAT cannot be used in multi-threaded mode" << endl;
-        exit(-1);
-    }
     if (nVars() > 0) {
         std::cerr << "ERROR: FRAT cannot be set after variables have been added" << endl;
         exit(-1);
     }
 
-    data->solvers[0]->conf.doBreakid = false;
-    data->solvers[0]->add_frat(os);
-    data->solvers[0]->conf.do_hyperbin_and_transred = true;
+    //All threads write into the same file, see FratFile::set_thread()
+    for(uint32_t i = 0; i < data->solvers.size(); i++) {
+        Solver& s = *data->solvers[i];
+        s.conf.doBreakid = false;
+        s.add_frat(os);
+        s.frat->set_thread(i, data->solvers.size());
+        s.conf.do_hyperbin_and_transred = true;
+    }
 }
 
 
@@ -35,8 +35,6 @@ using namespace CMSat;
 DataSync::DataSync(Solver* _solver, SharedData* _sharedData) :
     solver(_solver)
     , sharedData(_sharedData)
-    , seen(solver->seen)
-    , toClear(solver->toClear)
 {
 }
 
@@ -68,32 +66,15 @@ void DataSync::set_shared_data(SharedData* _sharedData)
 {
     sharedData = _sharedData;
     thread_id = _sharedData->cur_thread_id++;
+    ringReadAt.clear();
+    ringReadAt.resize(sharedData->rings.size(), 0);
+    unitReadAt.clear();
+    unitReadAt.resize(sharedData->units.size(), 0);
     #ifdef USE_MPI
     set_up_for_mpi();
     #endif
 }
 
-void DataSync::new_var(const bool bva)
-{
-    if (!enabled())
-        return;
-
-    if (!bva) {
-        syncFinish.push_back(0);
-        syncFinish.push_back(0);
-    }
-    assert(solver->nVarsOuter()*2 == syncFinish.size());
-}
-
-void DataSync::new_vars(size_t n)
-{
-    if (!enabled())
-        return;
-
-    syncFinish.insert(syncFinish.end(), 2*n, 0);
-    assert(solver->nVarsOuter()*2 == syncFinish.size());
-}
-
 void DataSync::save_on_var_memory()
 {
 }
@@ -116,11 +97,9 @@ bool DataSync::syncData()
     assert(sharedData != nullptr);
     assert(solver->decisionLevel() == 0);
 
-    //SEND data
+    //SEND and RECEIVE units
     bool ok;
-    sharedData->unit_mutex.lock();
     ok = shareUnitData();
-    sharedData->unit_mutex.unlock();
     if (!ok) {
         return false;
     }
@@ -129,12 +108,8 @@ bool DataSync::syncData()
         return false;
     }
 
-    //RECEIVE data
-    sharedData->bin_mutex.lock();
-    extend_bins_if_needed();
-    clear_set_binary_values();
-    ok = shareBinData();
-    sharedData->bin_mutex.unlock();
+    //RECEIVE data -- lock-free, through the per-thread rings
+    ok = shareClauseData();
     if (!ok) {
         return false;
     }
@@ -143,13 +118,11 @@ bool DataSync::syncData()
     if (solver->conf.is_mpi
         && solver->conf.thread_num == 0)
     {
-        if (syncMPIFinish.size() < solver->nVarsOutside()*2) {
-            syncMPIFinish.resize(solver->nVarsOutside()*2, 0);
+        if (mpiRingReadAt.size() < sharedData->rings.size()) {
+            mpiRingReadAt.resize(sharedData->rings.size(), 0);
         }
 
         if (!mpi_get_interrupt()) {
-            sharedData->unit_mutex.lock();
-            sharedData->bin_mutex.lock();
             ok = mpi_recv_from_others();
             assert(solver->conf.every_n_mpi_sync > 0);
             if (ok &&
@@ -157,8 +130,6 @@ bool DataSync::syncData()
             ) {
                 mpi_send_to_others();
             }
-            sharedData->unit_mutex.unlock();
-            sharedData->bin_mutex.unlock();
             if (!ok) {
                 return false;
             }
@@ -174,219 +145,223 @@ bool DataSync::syncData()
 bool DataSync::shareUnitData()
 {
     assert(solver->okay());
-    assert(!solver->frat->enabled());
-
-    uint32_t thisGotUnitData = 0;
-    uint32_t thisSentUnitData = 0;
 
-    SharedData& shared = *sharedData;
-    if (shared.value.size() < solver->nVarsOuter()) {
-        shared.value.insert(
-            shared.value.end(),
-            solver->nVarsOuter()-shared.value.size(), l_Undef);
+    const uint32_t oldRecvUnitData = stats.recvUnitData;
+    const uint32_t oldSentUnitData = stats.sentUnitData;
+    if (unitShared.size() < solver->nVarsOuter()) {
+        unitShared.resize(solver->nVarsOuter(), 0);
     }
-    for (uint32_t var = 0; var < solver->nVarsOuter(); var++) {
-        Lit thisLit = Lit(var, false);
-        thisLit = solver->varReplacer->get_lit_replaced_with_outer(thisLit);
-        thisLit = solver->map_outer_to_inter(thisLit);
-        const lbool thisVal = solver->value(thisLit);
-        const lbool otherVal = shared.value[var];
 
-        if (thisVal == l_Undef && otherVal == l_Undef) {
-            continue;
-        }
+    //Only look at what the others have fixed since the last sync
+    for(uint32_t t = 0; t < sharedData->units.size(); t++) {
+        if ((int)t == thread_id) continue;
 
-        if (thisVal != l_Undef && otherVal != l_Undef) {
-            if (thisVal != otherVal) {
-                solver->ok = false;
+        const AppendLog& log = *sharedData->units[t];
+        const uint64_t end = log.epoch();
+        for(uint64_t& at = unitReadAt[t]; at < end; at++) {
+            if (!import_unit(Lit::toLit(log.at(at)))) {
                 return false;
-            } else {
-                continue;
-            }
-        }
-
-        if (otherVal != l_Undef) {
-            assert(thisVal == l_Undef);
-            Lit litToEnqueue = thisLit ^ (otherVal == l_False);
-            if (solver->varData[litToEnqueue.var()].removed != Removed::none) {
-                continue;
             }
-
-            solver->enqueue<false>(litToEnqueue);
-
-            thisGotUnitData++;
-            continue;
-        }
-
-        if (thisVal != l_Undef) {
-            assert(otherVal == l_Undef);
-            shared.value[var] = thisVal;
-            thisSentUnitData++;
-            continue;
         }
     }
-    stats.recvUnitData += thisGotUnitData;
-    stats.sentUnitData += thisSentUnitData;
+    export_new_units();
 
     if (solver->conf.verbosity >= 1) {
         cout
         << "c [sync " << thread_id << "  ]"
-        << " got units " << thisGotUnitData
+        << " got units " << (stats.recvUnitData - oldRecvUnitData)
         << " (total: " << stats.recvUnitData << ")"
-        << " sent units " << thisSentUnitData
+        << " sent units " << (stats.sentUnitData - oldSentUnitData)
         << " (total: " << stats.sentUnitData << ")"
+        << " mem use: " << sharedData->calc_memory_use_units()/(1024*1024) << " M"
         << endl;
     }
 
     return true;
 }
 
-void CMSat::DataSync::signal_new_long_clause(const vector<Lit>& cl)
+bool DataSync::import_unit(const Lit outer_lit)
 {
-    if (!enabled()) return;
-    assert(thread_id != -1);
-    if (cl.size() == 2) signal_new_bin_clause(cl[0], cl[1]);
-}
+    if (outer_lit.var() >= solver->nVarsOuter()) {
+        return true;
+    }
+    unitShared[outer_lit.var()] = 1;
 
-bool DataSync::syncBinFromOthers()
-{
-    for (uint32_t wsLit = 0; wsLit < sharedData->bins.size(); wsLit++) {
-        if (sharedData->bins[wsLit].data == nullptr) {
-            continue;
-        }
+    Lit lit = solver->varReplacer->get_lit_replaced_with_outer(outer_lit);
+    lit = solver->map_outer_to_inter(lit);
+    if (solver->varData[lit.var()].removed != Removed::none) {
+        return true;
+    }
 
-        Lit lit1 = Lit::toLit(wsLit);
-        lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-        lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->varData[lit1.var()].removed != Removed::none
-            || solver->value(lit1.var()) != l_Undef
-        ) {
-            continue;
-        }
+    const lbool val = solver->value(lit);
+    if (val == l_True) {
+        return true;
+    }
 
-        vector<Lit>& bins = *sharedData->bins[wsLit].data;
-        watch_subarray ws = solver->watches[lit1];
+    //Don't send it back to the others
+    unitShared[solver->map_inter_to_outer(lit.var())] = 1;
+    stats.recvUnitData++;
 
-        assert(syncFinish.size() > wsLit);
-        if (bins.size() > syncFinish[wsLit]
-            && !syncBinFromOthers(lit1, bins, syncFinish[wsLit], ws)
-        ) {
-            return false;
-        }
+    if (solver->frat->enabled()) {
+        //Derived from the exporter's copy, see add_frat_shared()
+        vector<Lit>& cl = tmpImportCl;
+        cl.clear();
+        cl.push_back(lit);
+        solver->add_clause_int(cl);
+        return solver->okay();
     }
 
+    if (val == l_False) {
+        solver->ok = false;
+        return false;
+    }
+    solver->enqueue<false>(lit);
+
     return true;
 }
 
-bool DataSync::syncBinFromOthers(
-    const Lit lit
-    , const vector<Lit>& bins
-    , uint32_t& finished
-    , watch_subarray ws
-) {
-    assert(solver->varReplacer->get_lit_replaced_with(lit) == lit);
-    assert(solver->varData[lit.var()].removed == Removed::none);
-
-    assert(toClear.empty());
-    for (const Watched& w: ws) {
-        if (w.isBin()) {
-            toClear.push_back(w.lit2());
-            assert(seen.size() > w.lit2().toInt());
-            seen[w.lit2().toInt()] = true;
-        }
+void DataSync::export_new_units()
+{
+    if (!enabled()) return;
+    assert(solver->decisionLevel() == 0);
+    if (unitShared.size() < solver->nVarsOuter()) {
+        unitShared.resize(solver->nVarsOuter(), 0);
     }
 
-    vector<Lit> lits(2);
-    for (uint32_t i = finished; i < bins.size(); i++) {
-        Lit otherLit = bins[i];
-        otherLit = solver->varReplacer->get_lit_replaced_with_outer(otherLit);
-        otherLit = solver->map_outer_to_inter(otherLit);
-        if (solver->varData[otherLit.var()].removed != Removed::none
-            || solver->value(otherLit) != l_Undef
+    AppendLog& log = *sharedData->units[thread_id];
+    const uint32_t old_sent = stats.sentUnitData;
+    const auto& trail = solver->trail;
+    for(; trailExportedAt < trail.size(); trailExportedAt++) {
+        const Lit lit = trail[trailExportedAt].lit;
+        if (lit == lit_Undef
+            || solver->varData[lit.var()].is_bva
         ) {
             continue;
         }
-        assert(seen.size() > otherLit.toInt());
-        if (!seen[otherLit.toInt()]) {
-            stats.recvBinData++;
-            lits[0] = lit;
-            lits[1] = otherLit;
-
-            //Don't add FRAT: it would add to the thread data, too
-            solver->add_clause_int(lits, true, nullptr, true, nullptr, false);
-            if (!solver->okay()) {
-                goto end;
+
+        const Lit outer_lit = solver->map_inter_to_outer(lit);
+        export_unit(log, outer_lit);
+
+        //Variables replaced by this one are now fixed, too
+        if (solver->varReplacer->var_is_replacing(outer_lit.var())) {
+            for(const uint32_t v: solver->varReplacer->get_vars_replacing(lit.var())) {
+                const uint32_t outer_v = solver->map_inter_to_outer(v);
+                const Lit repl = solver->varReplacer->get_lit_replaced_with_outer(Lit(outer_v, false));
+                export_unit(log, Lit(outer_v, repl != outer_lit));
             }
         }
     }
-    finished = bins.size();
 
-    end:
-    for (const Lit l: toClear) {
-        seen[l.toInt()] = false;
+    //The FRAT copies must be in the file before anyone can import them
+    if (stats.sentUnitData != old_sent) solver->frat->flush();
+    log.publish();
+}
+
+void DataSync::export_unit(AppendLog& log, const Lit outer_lit)
+{
+    if (unitShared[outer_lit.var()]) return;
+    unitShared[outer_lit.var()] = 1;
+    log.push(outer_lit.toInt());
+    stats.sentUnitData++;
+
+    if (solver->frat->enabled()) {
+        vector<Lit>& cl = tmpImportCl;
+        cl.clear();
+        cl.push_back(solver->map_outer_to_inter(outer_lit));
+        add_frat_shared(cl);
     }
-    toClear.clear();
+}
 
-    return solver->okay();
+//Other threads' proofs derive what they import from these copies. They are
+//only finalized at the very end, see finalize_frat_shared().
+void DataSync::add_frat_shared(const vector<Lit>& cl)
+{
+    const int32_t ID = ++solver->clauseID;
+    *solver->frat << add << ID << cl << fin;
+    fratShared.push_back(ID);
+    fratShared.push_back(cl.size());
+    for(const Lit l: cl) fratShared.push_back(solver->map_inter_to_outer(l).toInt());
 }
 
-void DataSync::syncBinToOthers()
+void DataSync::finalize_frat_shared()
 {
-    for(const std::pair<Lit, Lit>& bin: newBinClauses) {
-        add_bin_to_threads(bin.first, bin.second);
+    vector<Lit>& cl = tmpImportCl;
+    size_t at = 0;
+    while(at < fratShared.size()) {
+        const int32_t ID = fratShared[at];
+        const uint32_t size = fratShared[at+1];
+        cl.clear();
+        for(uint32_t i = 0; i < size; i++) {
+            cl.push_back(solver->map_outer_to_inter(Lit::toLit(fratShared[at+2+i])));
+        }
+        at += 2 + size;
+        *solver->frat << finalcl << ID << cl << fin;
     }
-
-    newBinClauses.clear();
+    fratShared.clear();
 }
 
-bool DataSync::add_bin_to_threads(Lit lit1, Lit lit2)
+void CMSat::DataSync::signal_new_long_clause(const vector<Lit>& cl, const uint32_t glue)
 {
-    assert(lit1 < lit2);
-    if (sharedData->bins[lit1.toInt()].data == nullptr) {
-        return false;
+    if (!enabled()) return;
+    assert(thread_id != -1);
+    if (cl.size() == 2) {
+        signal_new_bin_clause(cl[0], cl[1]);
+        return;
     }
 
-    vector<Lit>& bins = *sharedData->bins[lit1.toInt()].data;
-    for (const Lit lit : bins) {
-        if (lit == lit2)
-            return false;
+    if (!solver->conf.share_long_cls
+        || cl.size() < 2
+        || cl.size() > solver->conf.share_long_cls_max_size
+        || glue > solver->conf.share_long_cls_max_glue
+    ) {
+        return;
+    }
+    for(const Lit l: cl) {
+        if (solver->varData[l.var()].is_bva) return;
     }
 
-    bins.push_back(lit2);
-    stats.sentBinData++;
-    return true;
+    if (solver->frat->enabled()) add_frat_shared(cl);
+    toExport.push_back(cl.size());
+    toExport.push_back(glue);
+    for(const Lit l: cl) {
+        toExport.push_back(solver->map_inter_to_outer(l).toInt());
+    }
 }
 
-void DataSync::clear_set_binary_values()
+void DataSync::signal_new_bin_clause(Lit lit1, Lit lit2)
 {
-    for(size_t i = 0; i < solver->nVarsOuter()*2; i++) {
-        Lit lit1 = Lit::toLit(i);
-        lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-        lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->value(lit1) != l_Undef) {
-            sharedData->bins[i].clear();
-        }
+    if (!enabled()) return;
+    if (solver->varData[lit1.var()].is_bva) return;
+    if (solver->varData[lit2.var()].is_bva) return;
+
+    if (solver->frat->enabled()) {
+        vector<Lit>& cl = tmpImportCl;
+        cl.clear();
+        cl.push_back(lit1);
+        cl.push_back(lit2);
+        add_frat_shared(cl);
     }
-}
 
-void DataSync::extend_bins_if_needed()
-{
-    assert(sharedData->bins.size() <= (solver->nVarsOuter())*2);
-    if (sharedData->bins.size() == (solver->nVarsOuter())*2)
-        return;
+    lit1 = solver->map_inter_to_outer(lit1);
+    lit2 = solver->map_inter_to_outer(lit2);
 
-    sharedData->bins.resize(solver->nVarsOuter()*2);
+    if (lit1.toInt() > lit2.toInt()) std::swap(lit1, lit2);
+    toExport.push_back(2);
+    toExport.push_back(2);
+    toExport.push_back(lit1.toInt());
+    toExport.push_back(lit2.toInt());
 }
 
-bool DataSync::shareBinData()
+bool DataSync::shareClauseData()
 {
     assert(solver->okay());
     uint32_t oldRecvBinData = stats.recvBinData;
     uint32_t oldSentBinData = stats.sentBinData;
+    uint32_t oldRecvLongData = stats.recvLongData;
+    uint32_t oldSentLongData = stats.sentLongData;
 
-    bool ok = syncBinFromOthers();
-    syncBinToOthers();
-    size_t mem = sharedData->calc_memory_use_bins();
+    bool ok = syncClausesFromOthers();
+    syncClausesToOthers();
 
     if (solver->conf.verbosity >= 1) {
         cout
@@ -395,24 +370,191 @@ bool DataSync::shareBinData()
         << " (total: " << stats.recvBinData << ")"
         << " sent bins " << (stats.sentBinData - oldSentBinData)
         << " (total: " << stats.sentBinData << ")"
-        << " mem use: " << mem/(1024*1024) << " M"
+        << endl;
+
+        cout
+        << "c [sync " << thread_id << "  ]"
+        << " got long " << (stats.recvLongData - oldRecvLongData)
+        << " (total: " << stats.recvLongData << ")"
+        << " sent long " << (stats.sentLongData - oldSentLongData)
+        << " (total: " << stats.sentLongData << ")"
+        << " lost words: " << stats.lostRingData
+        << " mem use: " << sharedData->calc_memory_use_rings()/(1024*1024) << " M"
         << endl;
     }
 
     return ok;
 }
 
-void DataSync::signal_new_bin_clause(Lit lit1, Lit lit2)
+bool DataSync::syncClausesFromOthers()
 {
-    if (!enabled()) return;
-    if (solver->varData[lit1.var()].is_bva) return;
-    if (solver->varData[lit2.var()].is_bva) return;
+    assert(ringReadAt.size() == sharedData->rings.size());
+    for(uint32_t t = 0; t < sharedData->rings.size(); t++) {
+        if ((int)t == thread_id) continue;
+
+        const ExportRing& ring = *sharedData->rings[t];
+        const uint64_t head = ring.epoch();
+        uint64_t& read_at = ringReadAt[t];
+        if (read_at == head) continue;
+
+        if (!ring.read(read_at, head, ringTmp)) {
+            //We were too slow and the producer lapped us. The data is gone,
+            //but the head is always at a record boundary, so continue there
+            stats.lostRingData += head - read_at;
+            read_at = head;
+            continue;
+        }
+        read_at = head;
 
-    lit1 = solver->map_inter_to_outer(lit1);
-    lit2 = solver->map_inter_to_outer(lit2);
+        if (!import_clauses(ringTmp)) {
+            return false;
+        }
+    }
 
-    if (lit1.toInt() > lit2.toInt()) std::swap(lit1, lit2);
-    newBinClauses.push_back(std::make_pair(lit1, lit2));
+    return true;
+}
+
+bool DataSync::import_clauses(const vector<uint32_t>& words)
+{
+    size_t at = 0;
+    while(at < words.size()) {
+        const uint32_t size = words[at];
+        const uint32_t glue = words[at+1];
+        const uint32_t* lits = words.data() + at + 2;
+        at += 2 + size;
+        assert(at <= words.size());
+
+        if (size == 2) {
+            if (!import_bin(Lit::toLit(lits[0]), Lit::toLit(lits[1]))) {
+                return false;
+            }
+        } else if (solver->conf.share_long_cls) {
+            if (!import_long(lits, size, glue)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool DataSync::import_bin(Lit lit1, Lit lit2)
+{
+    if (lit1.var() >= solver->nVarsOuter() || lit2.var() >= solver->nVarsOuter()) {
+        return true;
+    }
+
+    lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
+    lit1 = solver->map_outer_to_inter(lit1);
+    lit2 = solver->varReplacer->get_lit_replaced_with_outer(lit2);
+    lit2 = solver->map_outer_to_inter(lit2);
+    if (solver->varData[lit1.var()].removed != Removed::none
+        || solver->value(lit1) != l_Undef
+        || solver->varData[lit2.var()].removed != Removed::none
+        || solver->value(lit2) != l_Undef
+    ) {
+        return true;
+    }
+
+    for (const Watched& w: solver->watches[lit1]) {
+        if (w.isBin() && w.lit2() == lit2) {
+            return true;
+        }
+    }
+
+    stats.recvBinData++;
+    vector<Lit>& lits = tmpImportCl;
+    lits.clear();
+    lits.push_back(lit1);
+    lits.push_back(lit2);
+
+    //Derived from the exporter's copy, see add_frat_shared()
+    solver->add_clause_int(lits, true, nullptr, true, nullptr, true);
+    return solver->okay();
+}
+
+bool DataSync::import_long(
+    const uint32_t* lits
+    , const uint32_t size
+    , uint32_t glue
+) {
+    vector<Lit>& cl = tmpImportCl;
+    cl.clear();
+    for (uint32_t i = 0; i < size; i++) {
+        Lit lit = Lit::toLit(lits[i]);
+        if (lit.var() >= solver->nVarsOuter()) {
+            return true;
+        }
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        if (solver->varData[lit.var()].removed != Removed::none
+            || solver->value(lit) == l_True
+        ) {
+            return true;
+        }
+        cl.push_back(lit);
+    }
+    glue = std::min<uint32_t>(glue, cl.size());
+
+    //Put it into the same tier the searcher would have put it into
+    ClauseStats cl_stats;
+    cl_stats.glue = glue;
+    #ifndef FINAL_PREDICTOR
+    if (glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
+        cl_stats.which_red_array = 0;
+    } else if (
+        glue <= solver->conf.glue_put_lev1_if_below_or_eq
+        && solver->conf.glue_put_lev1_if_below_or_eq != 0
+    ) {
+        cl_stats.which_red_array = 1;
+    } else {
+        cl_stats.which_red_array = 2;
+    }
+    #else
+    cl_stats.which_red_array = 2;
+    #endif
+    stats.recvLongData++;
+
+    //Derived from the exporter's copy, see add_frat_shared()
+    Clause* c = solver->add_clause_int(cl, true, &cl_stats, true, nullptr, true);
+    if (c != nullptr) {
+        ClauseStatsExtra stats_extra;
+        stats_extra.last_touched_any = solver->sumConflicts;
+        #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
+        stats_extra.introduced_at_conflict = solver->sumConflicts;
+        stats_extra.orig_glue = glue;
+        stats_extra.orig_size = c->size();
+        #endif
+        solver->red_stats_extra[c->stats.extra_pos] = stats_extra;
+        const ClOffset offset = solver->cl_alloc.get_offset(c);
+        solver->longRedCls[c->stats.which_red_array].push_back(offset);
+    }
+
+    return solver->okay();
+}
+
+void DataSync::syncClausesToOthers()
+{
+    ExportRing& ring = *sharedData->rings[thread_id];
+
+    //Only whole records are published, and only as many as fit the ring
+    size_t at = 0;
+    while(at < toExport.size()) {
+        const uint32_t size = toExport[at];
+        if (at + 2 + size > ring.capacity()) break;
+        if (size == 2) stats.sentBinData++;
+        else stats.sentLongData++;
+        at += 2 + size;
+    }
+    stats.lostRingData += toExport.size() - at;
+    toExport.resize(at);
+
+    if (!toExport.empty()) {
+        //The FRAT copies must be in the file before anyone can import them
+        solver->frat->flush();
+        ring.write(toExport);
+    }
+    toExport.clear();
 }
 
 #ifdef USE_MPI
@@ -537,7 +679,16 @@ bool DataSync::mpi_recv_from_others()
         at++;
         for (uint32_t i = 0; i < num; i++, at++) {
             Lit otherLit = Lit::toLit(buf[at]);
-            thisMpiRecvBinData += add_bin_to_threads(lit, otherLit);
+
+            //Pass it on to the other threads, and take it ourselves, too
+            toExport.push_back(2);
+            toExport.push_back(2);
+            toExport.push_back(lit.toInt());
+            toExport.push_back(otherLit.toInt());
+            thisMpiRecvBinData++;
+            if (!import_bin(lit, otherLit)) {
+                goto end;
+            }
         }
     }
     mpiRecvBinData += thisMpiRecvBinData;
@@ -584,35 +735,41 @@ void DataSync::mpi_send_to_others()
     " Building data to send via MPI..." << std::endl;
     #endif
 
-    //Set up units
-    assert(solver->nVarsOutside() == sharedData->value.size());
+    //Set up units. We import all other threads' units, so ours are complete
     vector<uint32_t> data;
     data.push_back(solver->nVarsOutside());
     for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
-        data.push_back(toInt(sharedData->value[var]));
+        Lit lit = solver->map_to_with_bva(Lit(var, false));
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        data.push_back(toInt(solver->value(lit)));
     }
 
-    //Set up binaries
-    assert(sharedData->bins.size() == solver->nVarsOutside()*2);
+    //Set up binaries, collected from every thread's ring since last time
+    vector<vector<uint32_t>> bins(solver->nVarsOutside()*2);
     uint32_t thisMpiSentBinData = 0;
     data.push_back(solver->nVarsOutside()*2);
-
-    for(uint32_t wsLit = 0; wsLit < solver->nVarsOutside()*2; wsLit++) {
-        //Lit lit1 = ~Lit::toLit(wsLit);
-        assert(syncMPIFinish.size() > wsLit);
-        if (sharedData->bins[wsLit].data == nullptr) {
-            data.push_back(0);
-            continue;
+    for(uint32_t t = 0; t < sharedData->rings.size(); t++) {
+        const ExportRing& ring = *sharedData->rings[t];
+        const uint64_t head = ring.epoch();
+        if (!ring.read(mpiRingReadAt[t], head, ringTmp)) {
+            ringTmp.clear();
+        }
+        mpiRingReadAt[t] = head;
+        for(size_t at = 0; at < ringTmp.size(); at += 2 + ringTmp[at]) {
+            if (ringTmp[at] != 2) continue;
+            const uint32_t lit1 = ringTmp[at+2];
+            const uint32_t lit2 = ringTmp[at+3];
+            if (lit1 >= bins.size()) continue;
+            bins[lit1].push_back(lit2);
         }
-        uint32_t size = sharedData->bins[wsLit].data->size();
-        assert(size >= syncMPIFinish[wsLit]);
-        uint32_t sizeToSend = size - syncMPIFinish[wsLit];
-        data.push_back(sizeToSend);
-        for (uint32_t i = syncMPIFinish[wsLit]; i < size; i++) {
-            data.push_back(sharedData->bins[wsLit].data->at(i).toInt());
+    }
+    for(uint32_t wsLit = 0; wsLit < solver->nVarsOutside()*2; wsLit++) {
+        data.push_back(bins[wsLit].size());
+        for (const uint32_t lit2: bins[wsLit]) {
+            data.push_back(lit2);
             thisMpiSentBinData++;
         }
-        syncMPIFinish[wsLit] = size;
     }
     mpiSentBinData += thisMpiSentBinData;
 
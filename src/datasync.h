@@ -35,6 +35,7 @@ namespace CMSat {
 
 class Clause;
 class SharedData;
+class AppendLog;
 class Solver;
 class DataSync
 {
@@ -43,43 +44,57 @@ class DataSync
         void finish_up_mpi();
         bool enabled();
         void set_shared_data(SharedData* sharedData);
-        void new_var(const bool bva);
-        void new_vars(const size_t n);
         bool syncData();
         void save_on_var_memory();
         void updateVars(
            const vector<uint32_t>& outer_to_inter
             , const vector<uint32_t>& inter_to_outer
         );
-        void signal_new_long_clause(const vector<Lit>& clause);
+        void signal_new_long_clause(const vector<Lit>& clause, const uint32_t glue);
+        void export_new_units();
+        void finalize_frat_shared();
 
         struct Stats {
             uint32_t sentUnitData = 0;
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint32_t sentLongData = 0;
+            uint32_t recvLongData = 0;
+            uint64_t lostRingData = 0;
         };
         const Stats& get_stats() const;
 
     private:
-        void extend_bins_if_needed();
         bool shareUnitData();
-        bool shareBinData();
-        bool syncBinFromOthers();
-        bool syncBinFromOthers(const Lit lit, const vector<Lit>& bins, uint32_t& finished, watch_subarray ws);
-        void syncBinToOthers();
-        void clear_set_binary_values();
-        bool add_bin_to_threads(const Lit lit1, const Lit lit2);
+        bool import_unit(const Lit outer_lit);
+        void export_unit(AppendLog& log, const Lit outer_lit);
+        bool shareClauseData();
+        bool syncClausesFromOthers();
+        void syncClausesToOthers();
+        bool import_clauses(const vector<uint32_t>& words);
+        bool import_bin(Lit lit1, Lit lit2);
+        bool import_long(const uint32_t* lits, const uint32_t size, uint32_t glue);
         void signal_new_bin_clause(Lit lit1, Lit lit2);
+        void add_frat_shared(const vector<Lit>& cl);
 
         int thread_id = -1;
 
-        //stuff to sync
-        vector<std::pair<Lit, Lit>> newBinClauses;
+        //stuff to sync, same record layout as the ExportRing
+        vector<uint32_t> toExport;
+        vector<uint64_t> ringReadAt; //position read up to, per thread's ring
+        vector<uint32_t> ringTmp;
+        vector<Lit> tmpImportCl;
+        vector<uint64_t> unitReadAt; //position read up to, per thread's log
+        uint64_t trailExportedAt = 0;
+        vector<char> unitShared; //OUTER var already sent or received
+
+        //FRAT: copies of what we exported, never deleted, so importers can
+        //always derive them. Records are [ID, size, OUTER lits...]
+        vector<uint32_t> fratShared;
 
         //stats
         uint64_t lastSyncConf = 0;
-        vector<uint32_t> syncFinish;
         Stats stats;
 
         //Other systems
@@ -96,7 +111,7 @@ class DataSync
             const uint32_t var,
             uint32_t& thisGotUnitData
         );
-        vector<uint32_t> syncMPIFinish;
+        vector<uint64_t> mpiRingReadAt;
         MPI_Request   sendReq;
         uint32_t*     mpiSendData = nullptr;
 
@@ -109,8 +124,6 @@ class DataSync
 
         //misc
         uint32_t numCalls = 0;
-        vector<uint32_t>& seen;
-        vector<Lit>& toClear;
 };
 
 inline const DataSync::Stats& DataSync::get_stats() const
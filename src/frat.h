@@ -24,6 +24,9 @@ THE SOFTWARE.
 
 #include <vector>
 #include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "clause.h"
 #include "sqlstats.h"
@@ -68,6 +71,7 @@ public:
     virtual Frat& operator<<(const FratOutcome) { return *this; }
     virtual Frat& operator<<(const FratFlag) { return *this; }
     virtual void setFile(FILE*) { }
+    virtual void set_thread(uint32_t, uint32_t) { }
     virtual FILE* getFile() { return nullptr; }
     virtual void flush() {}
     virtual bool incremental() {return false;}
@@ -92,18 +96,37 @@ public:
         del_buf = new unsigned char[2 * 1024 * 1024];
         del_ptr = del_buf;
         del_len = 0;
+
+        write_buf = new unsigned char[2 * 1024 * 1024];
     }
 
     ~FratFile() override
     {
         flush();
+        if (writer.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(write_mutex);
+                write_quit = true;
+            }
+            write_cv.notify_all();
+            writer.join();
+        }
         delete[] drup_buf;
         delete[] del_buf;
+        delete[] write_buf;
     }
 
     void set_sumconflicts_ptr(uint64_t* _sumConflicts) override { sumConflicts = _sumConflicts; }
     void set_sqlstats_ptr(SQLStats* _sqlStats) override { sqlStats = _sqlStats; }
     void setFile(FILE* _file) override { drup_file = _file; }
+
+    //Many threads may write into the same file. Their IDs are interleaved,
+    //so they stay unique: local ID i of thread t becomes (i-1)*num+t+1
+    void set_thread(uint32_t _thread_num, uint32_t _num_threads) override {
+        assert(_thread_num < _num_threads);
+        thread_num = _thread_num;
+        num_threads = _num_threads;
+    }
     bool something_delayed() override { return delete_filled; }
     bool enabled() override { return true; }
 
@@ -116,9 +139,28 @@ public:
     }
 
     FILE* getFile() override { return drup_file; }
-    void flush() override { frat_flush(); }
+
+    //Hands everything over to the writer thread and waits until it's written
+    void flush() override {
+        frat_flush();
+        std::unique_lock<std::mutex> lock(write_mutex);
+        write_cv.wait(lock, [&]{ return !write_pending; });
+    }
+
+    //Double buffering: the full buffer is swapped with the one the writer
+    //thread has finished writing, so we only block if the disk can't keep up
     void frat_flush() {
-        fwrite(drup_buf, sizeof(unsigned char), buf_len, drup_file);
+        if (buf_len == 0) return;
+        if (!writer.joinable()) writer = std::thread(&FratFile::write_loop, this);
+
+        {
+            std::unique_lock<std::mutex> lock(write_mutex);
+            write_cv.wait(lock, [&]{ return !write_pending; });
+            std::swap(drup_buf, write_buf);
+            write_len = buf_len;
+            write_pending = true;
+        }
+        write_cv.notify_all();
         buf_ptr = drup_buf;
         buf_len = 0;
     }
@@ -379,24 +421,32 @@ private:
         return *this;
     }
 
-    void byteDRUPaID(const int32_t id)
+    int64_t global_id(const int32_t id) const
     {
-        if (adding && cl_id == 0) cl_id = id;
+        if (id < 0) return -global_id(-id);
+        return (int64_t)(id-1)*num_threads + thread_num + 1;
+    }
+
+    void byteDRUPaID(const int32_t local_id)
+    {
+        if (adding && cl_id == 0) cl_id = local_id;
+        const int64_t id = global_id(local_id);
         if (binfrat) {
             for(unsigned i = 0; i < 6; i++) buf_add((id>>(8*i))&0xff);
         } else {
-            uint32_t num = sprintf((char*)buf_ptr, "%d ", id);
+            uint32_t num = sprintf((char*)buf_ptr, "%lld ", (long long)id);
             buf_ptr+=num;
             buf_len+=num;
         }
     }
 
-    void byteDRUPdID(const int32_t id)
+    void byteDRUPdID(const int32_t local_id)
     {
+        const int64_t id = global_id(local_id);
         if (binfrat) {
             for(unsigned i = 0; i < 6; i++) del_add((id>>(8*i))&0xff);
         } else {
-            uint32_t num = sprintf((char*)del_ptr, "%d ", id);
+            uint32_t num = sprintf((char*)del_ptr, "%lld ", (long long)id);
             del_ptr+=num;
             del_len+=num;
         }
@@ -422,8 +472,34 @@ private:
         }
     }
 
+    void write_loop()
+    {
+        std::unique_lock<std::mutex> lock(write_mutex);
+        while(true) {
+            write_cv.wait(lock, [&]{ return write_pending || write_quit; });
+            if (!write_pending) break;
+
+            lock.unlock();
+            fwrite(write_buf, sizeof(unsigned char), write_len, drup_file);
+            lock.lock();
+            write_pending = false;
+            write_cv.notify_all();
+        }
+    }
+
+    //Background writer
+    std::thread writer;
+    std::mutex write_mutex;
+    std::condition_variable write_cv;
+    unsigned char* write_buf;
+    int write_len = 0;
+    bool write_pending = false;
+    bool write_quit = false;
+
     bool adding = false;
     int32_t cl_id = 0;
+    uint32_t thread_num = 0;
+    uint32_t num_threads = 1;
     FILE* drup_file = nullptr;
     vector<uint32_t>& inter_to_outerMain;
     uint64_t* sumConflicts = nullptr;
@@ -43,6 +43,7 @@ THE SOFTWARE.
 #include "solver.h"
 #include "time_mem.h"
 #include "varreplacer.h"
+#include "helperpool.h"
 
 using std::make_pair;
 
@@ -309,6 +310,7 @@ bool EGaussian::full_init(bool& created) {
 
     free_temps(); create_temps();
     delete_reasons(); xor_reasons.resize(num_rows);
+    build_col_rows();
 
     after_init_density = get_density();
 
@@ -333,6 +335,8 @@ void EGaussian::free_temps()
     tmp_col = nullptr;
     delete tmp_col2;
     tmp_col2 = nullptr;
+    delete elim_rows;
+    elim_rows = nullptr;
 }
 
 void EGaussian::create_temps()
@@ -366,6 +370,31 @@ void EGaussian::create_temps()
     tmp_col2->rhs() = 0;
 }
 
+//Must be called once mat is final, i.e. at the end of full_init()
+void EGaussian::build_col_rows()
+{
+    col_rows.resize(num_cols, num_rows);
+    for(uint32_t col = 0; col < num_cols; col++) {
+        col_rows[col].setZero();
+        col_rows[col].rhs() = 0;
+    }
+    for(uint32_t row = 0; row < num_rows; row++) {
+        const PackedRow r = mat[row];
+        for (uint32_t col = r.find_next_one(0)
+            ; col != numeric_limits<uint32_t>::max()
+            ; col = r.find_next_one(col+1)
+        ) {
+            col_rows[col].setBit(row);
+        }
+    }
+
+    const uint32_t num_64b = num_rows/64+(bool)(num_rows%64);
+    int64_t* x = new int64_t[num_64b+1];
+    tofree.push_back(x);
+    elim_rows = new PackedRow(num_64b, x);
+    elim_rows->rhs() = 0;
+}
+
 void EGaussian::xor_in_bdd(const uint32_t a, const uint32_t b)
 {
     for(uint32_t i = 0; i < reason_mat[a].size(); i ++) {
@@ -933,13 +962,61 @@ void EGaussian::prop_lit(
     solver->enqueue<false>(ret_lit_prop, lev, PropBy(matrix_no, row_i));
 }
 
+//Xors resp_row into all rows in elim_rows, and updates col_rows accordingly,
+//split over the helper threads. Returns false, doing nothing, if the helpers
+//are off or the elimination is too small to be worth waking them up
+bool EGaussian::xor_rows_with_helpers(const uint32_t resp_row_n)
+{
+    const PackedRow resp_row = mat[resp_row_n];
+    const GaussConf& gconf = solver->conf.gaussconf;
+    if (gconf.elim_helper_threads == 0) return false;
+
+    const uint32_t num_xors = elim_rows->popcnt();
+    if ((uint64_t)num_xors*(resp_row.size+1) < gconf.elim_helper_min_words) return false;
+
+    if (!solver->gauss_helpers) {
+        solver->gauss_helpers = std::make_unique<HelperPool>(gconf.elim_helper_threads);
+    }
+
+    to_xor.clear();
+    for (uint32_t row = elim_rows->find_next_one(0)
+        ; row != numeric_limits<uint32_t>::max()
+        ; row = elim_rows->find_next_one(row+1)
+    ) {
+        to_xor.push_back(row);
+    }
+    to_xor_cols.clear();
+    for (uint32_t col = resp_row.find_next_one(0)
+        ; col != numeric_limits<uint32_t>::max()
+        ; col = resp_row.find_next_one(col+1)
+    ) {
+        to_xor_cols.push_back(col);
+    }
+
+    //Every slice writes disjoint rows of mat, reason_mat and col_rows
+    const bool frat = solver->frat->enabled();
+    const size_t num_rows_xor = to_xor.size();
+    solver->gauss_helpers->parallel_for(
+        num_rows_xor + to_xor_cols.size(),
+        [&](size_t b, size_t e) {
+            for(size_t k = b; k < e; k++) {
+                if (k < num_rows_xor) {
+                    mat[to_xor[k]].xor_in(resp_row);
+                    if (frat) xor_in_bdd(to_xor[k], resp_row_n);
+                } else {
+                    col_rows[to_xor_cols[k-num_rows_xor]].xor_in(*elim_rows);
+                }
+            }
+        });
+    elim_helper_calls++;
+
+    return true;
+}
+
 void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd)
 {
     const uint32_t new_resp_row_n = gqd.new_resp_row;
-    PackedMatrix::iterator rowI = mat.begin();
-    PackedMatrix::iterator end = mat.end();
     const uint32_t new_resp_col = var_to_col[gqd.new_resp_var];
-    uint32_t row_i = 0;
     bool unsat_set = false;
 
     #ifdef VERBOSE_DEBUG
@@ -952,172 +1029,191 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd)
     #endif
     elim_called++;
 
-    while (rowI != end) {
-        //Row has a '1' in eliminating column, and it's not the row responsible
-        if (new_resp_row_n != row_i && (*rowI)[new_resp_col]) {
-
-            // detect original non-basic watch list change or not
-            uint32_t orig_non_resp_var = row_to_var_non_resp[row_i];
-            uint32_t orig_non_resp_col = var_to_col[orig_non_resp_var];
-            assert((*rowI)[orig_non_resp_col]);
-            VERBOSE_PRINT("--> This row " << row_i
-                << " is being watched on var: " << orig_non_resp_var + 1
-                << " i.e. it must contain '1' for this var's column");
-
-            assert(satisfied_xors[row_i] == 0);
+    //Rows that have a '1' in eliminating column, except the responsible one.
+    //All of them get the responsible row xor-ed in, so in the transpose, every
+    //column of the responsible row gets this set of rows xor-ed in
+    *elim_rows = col_rows[new_resp_col];
+    elim_rows->clearBit(new_resp_row_n);
+    const PackedRow resp_row = mat[new_resp_row_n];
+    const bool rows_xored = xor_rows_with_helpers(new_resp_row_n);
+    if (!rows_xored) {
+        for (uint32_t col = resp_row.find_next_one(0)
+            ; col != numeric_limits<uint32_t>::max()
+            ; col = resp_row.find_next_one(col+1)
+        ) {
+            col_rows[col].xor_in(*elim_rows);
+        }
+    }
+
+    for (uint32_t row_i = elim_rows->find_next_one(0)
+        ; row_i != numeric_limits<uint32_t>::max()
+        ; row_i = elim_rows->find_next_one(row_i+1)
+    ) {
+        PackedMatrix::iterator rowI = mat.begin() + row_i;
+        SLOW_DEBUG_DO(assert(rows_xored || (*rowI)[new_resp_col]));
+
+        // detect original non-basic watch list change or not
+        uint32_t orig_non_resp_var = row_to_var_non_resp[row_i];
+        uint32_t orig_non_resp_col = var_to_col[orig_non_resp_var];
+        assert(rows_xored || (*rowI)[orig_non_resp_col]);
+        VERBOSE_PRINT("--> This row " << row_i
+            << " is being watched on var: " << orig_non_resp_var + 1
+            << " i.e. it must contain '1' for this var's column");
+
+        assert(satisfied_xors[row_i] == 0);
+        if (!rows_xored) {
             (*rowI).xor_in(*(mat.begin() + new_resp_row_n));
             if (solver->frat->enabled()) xor_in_bdd(row_i, new_resp_row_n);
+        }
 
-            elim_xored_rows++;
-
-            //NOTE: responsible variable cannot be eliminated of course
-            //      (it's the only '1' in that column).
-            //      But non-responsible can be eliminated. So let's check that
-            //      and then deal with it if we have to
-            if (!(*rowI)[orig_non_resp_col]) {
-
-                #ifdef VERBOSE_DEBUG
-                cout
-                << "--> This row " << row_i
-                << " can no longer be watched (non-responsible), it has no '1' at col " << orig_non_resp_col
-                << " (var " << col_to_var[orig_non_resp_col]+1 << ")"
-                << " fixing up..."<< endl;
-                #endif
-
-                // Delete original non-responsible var from watch list
-                if (orig_non_resp_var != gqd.new_resp_var) {
-                    #ifndef LAZY_DELETE_HACK
-                    delete_gausswatch(row_i);
-                    #endif
-                } else {
-                     //this does not need a delete, because during
-                     //find_truths, we already did clear_gwatches of the
-                     //orig_non_resp_var, so there is nothing to delete here
-                 }
-
-                Lit ret_lit_prop;
-                uint32_t new_non_resp_var = 0;
-                #ifdef SLOW_DEBUG
-                check_cols_unset_vals();
+        elim_xored_rows++;
+
+        //NOTE: responsible variable cannot be eliminated of course
+        //      (it's the only '1' in that column).
+        //      But non-responsible can be eliminated. So let's check that
+        //      and then deal with it if we have to
+        if (!(*rowI)[orig_non_resp_col]) {
+
+            #ifdef VERBOSE_DEBUG
+            cout
+            << "--> This row " << row_i
+            << " can no longer be watched (non-responsible), it has no '1' at col " << orig_non_resp_col
+            << " (var " << col_to_var[orig_non_resp_col]+1 << ")"
+            << " fixing up..."<< endl;
+            #endif
+
+            // Delete original non-responsible var from watch list
+            if (orig_non_resp_var != gqd.new_resp_var) {
+                #ifndef LAZY_DELETE_HACK
+                delete_gausswatch(row_i);
                 #endif
-                const gret ret = (*rowI).propGause(
-                    solver->assigns,
-                    col_to_var,
-                    var_has_resp_row,
-                    new_non_resp_var,
-                    *tmp_col,
-                    *tmp_col2,
-                    *cols_vals,
-                    *cols_unset,
-                    ret_lit_prop
-                );
-                elim_called_propgause++;
-
-                switch (ret) {
-                    case gret::confl: {
-                        elim_ret_confl++;
-                        VERBOSE_PRINT("---> conflict during eliminate_col's fixup");
-                        solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
-
-                        // update in this row non-basic variable
-                        row_to_var_non_resp[row_i] = p;
+            } else {
+                 //this does not need a delete, because during
+                 //find_truths, we already did clear_gwatches of the
+                 //orig_non_resp_var, so there is nothing to delete here
+             }
+
+            Lit ret_lit_prop;
+            uint32_t new_non_resp_var = 0;
+            #ifdef SLOW_DEBUG
+            check_cols_unset_vals();
+            #endif
+            const gret ret = (*rowI).propGause(
+                solver->assigns,
+                col_to_var,
+                var_has_resp_row,
+                new_non_resp_var,
+                *tmp_col,
+                *tmp_col2,
+                *cols_vals,
+                *cols_unset,
+                ret_lit_prop
+            );
+            elim_called_propgause++;
+
+            switch (ret) {
+                case gret::confl: {
+                    elim_ret_confl++;
+                    VERBOSE_PRINT("---> conflict during eliminate_col's fixup");
+                    solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
+
+                    // update in this row non-basic variable
+                    row_to_var_non_resp[row_i] = p;
+
+                    xor_reasons[row_i].must_recalc = true;
+                    xor_reasons[row_i].propagated = lit_Undef;
+                    gqd.confl = PropBy(matrix_no, row_i);
+                    gqd.ret = gauss_res::confl;
+
+                    // have to get reason if toplevel (reason will never be asked)
+                    if (solver->decisionLevel() == 0 && solver->frat->enabled() && !unsat_set) {
+                        VERBOSE_PRINT("-> conflict at toplevel during eliminate_col");
+                        int32_t ID;
+                        get_reason(row_i, ID); // needed to make below step valid
+                                               // but we don't really need the reason
+                        int32_t fin_ID = ++solver->clauseID;
+                        *solver->frat << add << fin_ID << fin;
+                        set_unsat_cl_id(fin_ID);
+                        unsat_set = true;
+                    }
 
-                        xor_reasons[row_i].must_recalc = true;
-                        xor_reasons[row_i].propagated = lit_Undef;
-                        gqd.confl = PropBy(matrix_no, row_i);
-                        gqd.ret = gauss_res::confl;
-
-                        // have to get reason if toplevel (reason will never be asked)
-                        if (solver->decisionLevel() == 0 && solver->frat->enabled() && !unsat_set) {
-                            VERBOSE_PRINT("-> conflict at toplevel during eliminate_col");
-                            int32_t ID;
-                            get_reason(row_i, ID); // needed to make below step valid
-                                                   // but we don't really need the reason
-                            int32_t fin_ID = ++solver->clauseID;
-                            *solver->frat << add << fin_ID << fin;
-                            set_unsat_cl_id(fin_ID);
-                            unsat_set = true;
-                        }
+                    break;
+                }
+                case gret::prop: {
+                    elim_ret_prop++;
+                    VERBOSE_PRINT("---> propagation during eliminate_col's fixup");
 
-                        break;
-                    }
-                    case gret::prop: {
-                        elim_ret_prop++;
-                        VERBOSE_PRINT("---> propagation during eliminate_col's fixup");
-
-                        // if conflicted already, just update non-basic variable
-                        if (gqd.ret == gauss_res::confl) {
-                            SLOW_DEBUG_DO(check_row_not_in_watch(p, row_i));
-                            solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
-                            row_to_var_non_resp[row_i] = p;
-                            break;
-                        }
-
-                        // update no_basic information
+                    // if conflicted already, just update non-basic variable
+                    if (gqd.ret == gauss_res::confl) {
                         SLOW_DEBUG_DO(check_row_not_in_watch(p, row_i));
                         solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
                         row_to_var_non_resp[row_i] = p;
-
-                        xor_reasons[row_i].must_recalc = true;
-                        xor_reasons[row_i].propagated = ret_lit_prop;
-                        assert(solver->value(ret_lit_prop.var()) == l_Undef);
-                        prop_lit(gqd, row_i, ret_lit_prop);
-
-                        update_cols_vals_set(ret_lit_prop);
-                        gqd.ret = gauss_res::prop;
-
-                        VERBOSE_PRINT("---> Satisfied XORs set for row: " << row_i);
-                        satisfied_xors[row_i] = 1;
-                        SLOW_DEBUG_DO(assert(check_row_satisfied(row_i)));
                         break;
                     }
 
-                    // find new watch list
-                    case gret::nothing_fnewwatch:
-                        elim_ret_fnewwatch++;
-                        #ifdef VERBOSE_DEBUG
-                        cout
-                        << "---> Nothing, clause NOT already satisfied, pushing in "
-                        << new_non_resp_var+1 << " as non-responsible var ( "
-                        << row_i << " row) "
-                        << endl;
-                        #endif
-
-                        SLOW_DEBUG_DO(check_row_not_in_watch(new_non_resp_var, row_i));
-                        solver->gwatches[new_non_resp_var].push(GaussWatched(row_i, matrix_no));
-                        row_to_var_non_resp[row_i] = new_non_resp_var;
-                        break;
-
-                    // this row already satisfied
-                    case gret::nothing_satisfied:
-                        elim_ret_satisfied++;
-                        VERBOSE_PRINT("---> Nothing to do, already satisfied , pushing in "
-                        << p+1 << " as non-responsible var ( "
-                        << row_i << " row) ");
+                    // update no_basic information
+                    SLOW_DEBUG_DO(check_row_not_in_watch(p, row_i));
+                    solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
+                    row_to_var_non_resp[row_i] = p;
 
-                        // printf("%d:This row is nothing( maybe already true) in eliminate col
-                        // n",num_row);
+                    xor_reasons[row_i].must_recalc = true;
+                    xor_reasons[row_i].propagated = ret_lit_prop;
+                    assert(solver->value(ret_lit_prop.var()) == l_Undef);
+                    prop_lit(gqd, row_i, ret_lit_prop);
 
-                        SLOW_DEBUG_DO(check_row_not_in_watch(p, row_i));
-                        solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
-                        row_to_var_non_resp[row_i] = p;
+                    update_cols_vals_set(ret_lit_prop);
+                    gqd.ret = gauss_res::prop;
 
-                        VERBOSE_PRINT("---> Satisfied XORs set for row: " << row_i);
-                        satisfied_xors[row_i] = 1;
-                        SLOW_DEBUG_DO(assert(check_row_satisfied(row_i)));
-                        break;
-                    default:
-                        // can not here
-                        assert(false);
-                        break;
+                    VERBOSE_PRINT("---> Satisfied XORs set for row: " << row_i);
+                    satisfied_xors[row_i] = 1;
+                    SLOW_DEBUG_DO(assert(check_row_satisfied(row_i)));
+                    break;
                 }
-            } else {
-                VERBOSE_PRINT("--> OK, this row " << row_i << " still contains '1', can still be responsible");
+
+                // find new watch list
+                case gret::nothing_fnewwatch:
+                    elim_ret_fnewwatch++;
+                    #ifdef VERBOSE_DEBUG
+                    cout
+                    << "---> Nothing, clause NOT already satisfied, pushing in "
+                    << new_non_resp_var+1 << " as non-responsible var ( "
+                    << row_i << " row) "
+                    << endl;
+                    #endif
+
+                    SLOW_DEBUG_DO(check_row_not_in_watch(new_non_resp_var, row_i));
+                    solver->gwatches[new_non_resp_var].push(GaussWatched(row_i, matrix_no));
+                    row_to_var_non_resp[row_i] = new_non_resp_var;
+                    break;
+
+                // this row already satisfied
+                case gret::nothing_satisfied:
+                    elim_ret_satisfied++;
+                    VERBOSE_PRINT("---> Nothing to do, already satisfied , pushing in "
+                    << p+1 << " as non-responsible var ( "
+                    << row_i << " row) ");
+
+                    // printf("%d:This row is nothing( maybe already true) in eliminate col
+                    // n",num_row);
+
+                    SLOW_DEBUG_DO(check_row_not_in_watch(p, row_i));
+                    solver->gwatches[p].push(GaussWatched(row_i, matrix_no));
+                    row_to_var_non_resp[row_i] = p;
+
+                    VERBOSE_PRINT("---> Satisfied XORs set for row: " << row_i);
+                    satisfied_xors[row_i] = 1;
+                    SLOW_DEBUG_DO(assert(check_row_satisfied(row_i)));
+                    break;
+                default:
+                    // can not here
+                    assert(false);
+                    break;
             }
+        } else {
+            VERBOSE_PRINT("--> OK, this row " << row_i << " still contains '1', can still be responsible");
         }
-        ++rowI;
-        row_i++;
     }
+    SLOW_DEBUG_DO(check_col_rows());
 
     // Debug_funtion();
     #ifdef VERBOSE_DEBUG
@@ -1192,6 +1288,11 @@ void EGaussian::print_matrix_stats(uint32_t verbosity)
         cout << pre << "-> lead to xor rows     : "
         << print_value_kilo_mega(elim_xored_rows, false) << endl;
 
+        if (solver->conf.gaussconf.elim_helper_threads) {
+            cout << pre << "-> xored by helpers     : "
+            << print_value_kilo_mega(elim_helper_calls, false) << endl;
+        }
+
         cout << pre << "--> lead to prop checks : "
         << print_value_kilo_mega(elim_called_propgause, false) << endl;
 
@@ -1417,6 +1518,15 @@ bool EGaussian::check_row_satisfied(const uint32_t row)
     return ret && fin == false;
 }
 
+void EGaussian::check_col_rows()
+{
+    for(uint32_t row = 0; row < num_rows; row++) {
+        for(uint32_t col = 0; col < num_cols; col++) {
+            assert(mat[row][col] == col_rows[col][row]);
+        }
+    }
+}
+
 void EGaussian::check_cols_unset_vals()
 {
     for(uint32_t i = 0; i < num_cols; i ++) {
@@ -126,12 +126,16 @@ class EGaussian {
     void select_columnorder();
     gret init_adjust_matrix(); // adjust matrix, include watch, check row is zero, etc.
     double get_density();
+    void build_col_rows();
 
     //Helper functions
     void prop_lit(
         const GaussQData& gqd, const uint32_t row_i, const Lit ret_lit_prop);
 
     void xor_in_bdd(const uint32_t a, const uint32_t b);
+    bool xor_rows_with_helpers(const uint32_t resp_row_n);
+    vector<uint32_t> to_xor; ///<rows of elim_rows, for the helpers
+    vector<uint32_t> to_xor_cols; ///<cols of the responsible row, for the helpers
     Xor xor_reason_create(const uint32_t row_n);
     void create_unit_bdd_reason(const uint32_t row_n);
 
@@ -153,6 +157,7 @@ class EGaussian {
     uint64_t elim_ret_confl = 0;
     uint64_t elim_ret_satisfied = 0;
     uint64_t elim_ret_fnewwatch = 0;
+    uint64_t elim_helper_calls = 0;
     double before_init_density = 0;
     double after_init_density = 0;
 
@@ -178,6 +183,9 @@ class EGaussian {
 
 
     PackedMatrix mat;
+    ///Transpose of mat: col_rows[COL] has bit ROW set iff mat[ROW][COL] is 1.
+    ///Lets eliminate_col() visit only the rows that have a 1 in the column
+    PackedMatrix col_rows;
     vector<vector<char>> reason_mat;
     vector<uint32_t>  var_to_col; ///var->col mapping. Index with VAR
     vector<uint32_t> col_to_var; ///col->var mapping. Index with COL
@@ -189,6 +197,7 @@ class EGaussian {
     PackedRow *cols_unset = nullptr;
     PackedRow *tmp_col = nullptr;
     PackedRow *tmp_col2 = nullptr;
+    PackedRow *elim_rows = nullptr; ///<num_rows wide, rows to xor in eliminate_col()
     void update_cols_vals_set(const Lit lit1);
     void create_temps();
     void free_temps();
@@ -203,6 +212,7 @@ class EGaussian {
     ///////////////
     void print_matrix();
     void check_cols_unset_vals();
+    void check_col_rows();
 };
 
 inline void EGaussian::canceling() {
@@ -22,32 +22,42 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define Glucose_Heap_h
 
 #include <iostream>
+#include <algorithm>
 #include "Vec.h"
 
 namespace CMSat {
 
 //=================================================================================================
-// A heap implementation with support for decrease/increase key.
+// A D-ary heap implementation with support for decrease/increase key.
+//
+// The D children of a node are next to each other, so with D=4 or D=8 a
+// percolateDown() reads one or two cache lines per level, and the heap is
+// half or a third as deep as a binary one.
 
 
-template<class Comp>
+template<class Comp, int D = 2>
 class Heap {
+    static_assert(D >= 2, "Heap arity must be at least 2");
+
     Comp     lt;       // The heap is a minimum-heap with respect to this comparator
     vec<int> heap;     // Heap of integers
     vec<int> indices;  // Each integers position (index) in the Heap
+    vec<int> decreased; // Elements decreased with decrease_later(), not yet percolated
 
     // Index "traversal" functions
-    static inline int left  (int i)
+    static inline int child (int i)
     {
-        return i * 2 + 1;
+        return i * D + 1;
     }
-    static inline int right (int i)
+    static inline int parent(int i)
     {
-        return (i + 1) * 2;
+        return (i - 1) / D;
     }
-    static inline int parent(int i)
+
+    // Position of 'n', or -1 if not in the heap
+    int pos(const int n) const
     {
-        return (i - 1) >> 1;
+        return n < static_cast<int>(indices.size()) ? indices[n] : -1;
     }
 
 
@@ -70,14 +80,20 @@ class Heap {
     void percolateDown(int i)
     {
         int x = heap[i];
-        while (left(i) < static_cast<int>(heap.size())) {
-            int child = right(i) < static_cast<int>(heap.size()) && lt(heap[right(i)], heap[left(i)]) ? right(i) : left(i);
-            if (!lt(heap[child], x)) {
+        const int sz = heap.size();
+        while (child(i) < sz) {
+            const int first = child(i);
+            const int last = std::min(first + D, sz);
+            int best = first;
+            for (int c = first + 1; c < last; c++) {
+                if (lt(heap[c], heap[best])) best = c;
+            }
+            if (!lt(heap[best], x)) {
                 break;
             }
-            heap[i]          = heap[child];
+            heap[i]          = heap[best];
             indices[heap[i]] = i;
-            i                = child;
+            i                = best;
         }
         heap   [i] = x;
         indices[x] = i;
@@ -117,24 +133,56 @@ public:
     [[nodiscard]] int operator[](int index) const
     {
         assert(index < static_cast<int>(heap.size()));
+        assert(decreased.empty());
         return heap[index];
     }
 
     void decrease  (int n)
     {
         assert(inHeap(n));
+        flush_decreased();
         percolateUp  (indices[n]);
     }
     void increase  (int n)
     {
         assert(inHeap(n));
+        flush_decreased();
         percolateDown(indices[n]);
     }
 
+    // Like decrease(), but only percolates 'n' up at the next flush_decreased(),
+    // which every other modifying call does first. An element bumped many
+    // times in between is percolated once, and all of them in one go.
+    // Until then a decreased element may be smaller than its parent, so only
+    // the minimum can be wrong.
+    void decrease_later(int n)
+    {
+        assert(inHeap(n));
+        decreased.push(n);
+    }
+
+    // Percolates parents before their children. A child flushed first could
+    // otherwise end up below an element its parent's percolation moves down.
+    // Elements still waiting never move, as only their ancestors percolate.
+    void flush_decreased()
+    {
+        if (decreased.empty()) return;
+        std::sort(decreased.begin(), decreased.end(),
+            [&](const int a, const int b) { return pos(a) < pos(b); });
+        int last = -1;
+        for (const int n: decreased) {
+            if (n == last || !inHeap(n)) continue;
+            last = n;
+            percolateUp(indices[n]);
+        }
+        decreased.clear();
+    }
+
 
     // Safe variant of insert/decrease/increase:
     void update(int n)
     {
+        flush_decreased();
         if (!inHeap(n)) {
             insert(n);
         } else {
@@ -146,6 +194,7 @@ public:
 
     void insert(int n)
     {
+        flush_decreased();
         indices.growTo(n + 1, -1);
         assert(!inHeap(n));
 
@@ -157,6 +206,7 @@ public:
 
     int  removeMin()
     {
+        flush_decreased();
         int x            = heap[0];
         heap[0]          = heap.last();
         indices[heap[0]] = 0;
@@ -173,6 +223,7 @@ public:
     template<typename T>
     void build(const T& ns)
     {
+        decreased.clear();
         for (int i = 0; i < static_cast<int>(ns.size()); i++) {
             indices.growTo(ns[i]+1, -1);
         }
@@ -187,8 +238,10 @@ public:
             heap.push(ns[i]);
         }
 
-        for (int i = static_cast<int>(heap.size()) / 2 - 1; i >= 0; i--) {
-            percolateDown(i);
+        if (heap.size() > 1) {
+            for (int i = parent(static_cast<int>(heap.size()) - 1); i >= 0; i--) {
+                percolateDown(i);
+            }
         }
     }
 
@@ -198,6 +251,7 @@ public:
             indices[heap[i]] = -1;
         }
         heap.clear(dealloc);
+        decreased.clear(dealloc);
     }
 
     size_t mem_used() const
@@ -205,19 +259,16 @@ public:
         size_t mem = 0;
         mem += heap.capacity()*sizeof(uint32_t);
         mem += indices.capacity()*sizeof(uint32_t);
+        mem += decreased.capacity()*sizeof(uint32_t);
         return mem;
     }
 
-    bool heap_property (uint32_t i) const {
-        return i >= heap.size()
-            || ( (i == 0 || !lt(heap[i], heap[parent(i)]))
-                  && heap_property( left(i)  )
-                  && heap_property( right(i) )
-            );
-    }
-
+    // Only holds after flush_decreased()
     bool heap_property() const {
-        return heap_property(0);
+        for (uint32_t i = 1; i < heap.size(); i++) {
+            if (lt(heap[i], heap[parent(i)])) return false;
+        }
+        return true;
     }
 
 };
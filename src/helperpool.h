@@ -0,0 +1,129 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <utility>
+
+namespace CMSat {
+
+/**
+@brief A few helper threads that split a loop with the calling thread
+
+parallel_for(n, f) calls f(begin, end) on disjoint slices of [0, n), one slice
+per helper plus one for the caller, and returns once all slices are done.
+Meant for short, data-parallel bursts in the middle of search, e.g. xor-ing
+many rows of a Gauss matrix, so the helpers sleep on a condition variable in
+between and the work function must not touch anything shared by the slices.
+*/
+class HelperPool
+{
+public:
+    explicit HelperPool(const uint32_t num_helpers)
+    {
+        for(uint32_t i = 0; i < num_helpers; i++) {
+            helpers.emplace_back([this, i]() { run(i+1); });
+        }
+    }
+
+    HelperPool(const HelperPool&) = delete;
+    HelperPool& operator=(const HelperPool&) = delete;
+
+    ~HelperPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            quit = true;
+        }
+        start_cv.notify_all();
+        for(auto& t: helpers) t.join();
+    }
+
+    uint32_t num_slices() const { return helpers.size()+1; }
+
+    void parallel_for(const size_t n, const std::function<void(size_t, size_t)>& f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            work = &f;
+            work_n = n;
+            pending = helpers.size();
+            generation++;
+        }
+        start_cv.notify_all();
+
+        const auto [b, e] = slice(0, n);
+        f(b, e);
+
+        std::unique_lock<std::mutex> lock(mu);
+        done_cv.wait(lock, [this]() { return pending == 0; });
+        work = nullptr;
+    }
+
+private:
+    std::pair<size_t, size_t> slice(const uint32_t at, const size_t n) const
+    {
+        const size_t per = n/num_slices();
+        const size_t extra = n%num_slices();
+        const size_t b = at*per + std::min<size_t>(at, extra);
+        return {b, b + per + (at < extra)};
+    }
+
+    void run(const uint32_t at)
+    {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mu);
+        while (true) {
+            start_cv.wait(lock, [&]() { return quit || generation != seen; });
+            if (quit) return;
+            seen = generation;
+            const auto* f = work;
+            const auto [b, e] = slice(at, work_n);
+            lock.unlock();
+
+            if (b != e) (*f)(b, e);
+
+            lock.lock();
+            if (--pending == 0) done_cv.notify_one();
+        }
+    }
+
+    std::vector<std::thread> helpers;
+    std::mutex mu;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    const std::function<void(size_t, size_t)>* work = nullptr;
+    size_t work_n = 0;
+    uint32_t pending = 0;
+    uint64_t generation = 0;
+    bool quit = false;
+};
+
+}
@@ -59,10 +59,6 @@ bool InTree::replace_until_fixedpoint(bool& aborted)
         bool OK = solver->varReplacer->replace_if_enough_is_found(0, &bogoprops);
         if (!OK) return false;
 
-        if (solver->varReplacer->get_scc_depth_warning_triggered()) {
-            aborted = true;
-            return solver->okay();
-        }
         this_replace = solver->varReplacer->get_num_replaced_vars();
 
         if (bogoprops > time_limit) {
@@ -0,0 +1,237 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "louvain.h"
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+using namespace CMSat;
+
+Louvain::Louvain(const uint32_t num_vertices, vector<Edge>& edges)
+{
+    //Each undirected edge once, a < b, duplicates merged
+    size_t j = 0;
+    for(size_t i = 0; i < edges.size(); i++) {
+        Edge e = edges[i];
+        if (e.a == e.b) continue;
+        if (e.b < e.a) std::swap(e.a, e.b);
+        assert(e.b < num_vertices);
+        edges[j++] = e;
+    }
+    edges.resize(j);
+    std::sort(edges.begin(), edges.end(), [](const Edge& x, const Edge& y) {
+        return x.a < y.a || (x.a == y.a && x.b < y.b);
+    });
+    j = 0;
+    for(size_t i = 0; i < edges.size(); i++) {
+        if (j > 0 && edges[j-1].a == edges[i].a && edges[j-1].b == edges[i].b) {
+            edges[j-1].w += edges[i].w;
+        } else {
+            edges[j++] = edges[i];
+        }
+    }
+    edges.resize(j);
+
+    //Symmetric CSR
+    graph.offs.assign(num_vertices+1, 0);
+    for(const auto& e: edges) {
+        graph.offs[e.a+1]++;
+        graph.offs[e.b+1]++;
+    }
+    for(uint32_t v = 0; v < num_vertices; v++) graph.offs[v+1] += graph.offs[v];
+    graph.adj.resize(graph.offs.back());
+    graph.w.resize(graph.offs.back());
+    graph.loop.assign(num_vertices, 0);
+    vector<uint64_t> at(graph.offs.begin(), graph.offs.end()-1);
+    for(const auto& e: edges) {
+        graph.adj[at[e.a]] = e.b;
+        graph.w[at[e.a]++] = e.w;
+        graph.adj[at[e.b]] = e.a;
+        graph.w[at[e.b]++] = e.w;
+    }
+    edges.clear();
+    edges.shrink_to_fit();
+
+    m2 = 0;
+    for(const double x: graph.w) m2 += x;
+}
+
+bool Louvain::one_level(const Graph& g, vector<uint32_t>& comm, uint32_t& num_comms)
+{
+    const uint32_t n = g.size();
+    vector<double> k(n);
+    vector<double> tot(n);
+    for(uint32_t v = 0; v < n; v++) {
+        k[v] = g.loop[v];
+        for(uint64_t i = g.offs[v]; i < g.offs[v+1]; i++) k[v] += g.w[i];
+        comm[v] = v;
+        tot[v] = k[v];
+    }
+    neigh_w.assign(n, -1.0);
+
+    bool moved_any = false;
+    for(uint32_t pass = 0; pass < 50; pass++) {
+        uint32_t moved = 0;
+        for(uint32_t v = 0; v < n; v++) {
+            const uint32_t old_c = comm[v];
+            touched.clear();
+            neigh_w[old_c] = 0;
+            touched.push_back(old_c);
+            for(uint64_t i = g.offs[v]; i < g.offs[v+1]; i++) {
+                const uint32_t c = comm[g.adj[i]];
+                if (neigh_w[c] < 0) {
+                    neigh_w[c] = 0;
+                    touched.push_back(c);
+                }
+                neigh_w[c] += g.w[i];
+            }
+
+            tot[old_c] -= k[v];
+            uint32_t best = old_c;
+            double best_gain = neigh_w[old_c] - tot[old_c]*k[v]/m2;
+            for(const uint32_t c: touched) {
+                const double gain = neigh_w[c] - tot[c]*k[v]/m2;
+                if (gain > best_gain + 1e-12) {
+                    best_gain = gain;
+                    best = c;
+                }
+            }
+            tot[best] += k[v];
+            comm[v] = best;
+            if (best != old_c) moved++;
+            for(const uint32_t c: touched) neigh_w[c] = -1.0;
+        }
+        if (moved == 0) break;
+        moved_any = true;
+        //Diminishing returns, the next level will pick up the rest
+        if (moved < n/1000) break;
+    }
+
+    //Number communities from 0
+    vector<uint32_t> renum(n, std::numeric_limits<uint32_t>::max());
+    num_comms = 0;
+    for(uint32_t v = 0; v < n; v++) {
+        if (renum[comm[v]] == std::numeric_limits<uint32_t>::max()) {
+            renum[comm[v]] = num_comms++;
+        }
+        comm[v] = renum[comm[v]];
+    }
+    return moved_any && num_comms < n;
+}
+
+Louvain::Graph Louvain::contract(
+    const Graph& g, const vector<uint32_t>& comm, const uint32_t num_comms)
+{
+    const uint32_t n = g.size();
+    vector<uint32_t> members_offs(num_comms+1, 0);
+    for(uint32_t v = 0; v < n; v++) members_offs[comm[v]+1]++;
+    for(uint32_t c = 0; c < num_comms; c++) members_offs[c+1] += members_offs[c];
+    vector<uint32_t> members(n);
+    vector<uint32_t> at(members_offs.begin(), members_offs.end()-1);
+    for(uint32_t v = 0; v < n; v++) members[at[comm[v]]++] = v;
+
+    Graph ng;
+    ng.offs.reserve(num_comms+1);
+    ng.offs.push_back(0);
+    ng.loop.assign(num_comms, 0);
+    neigh_w.assign(num_comms, -1.0);
+    for(uint32_t c = 0; c < num_comms; c++) {
+        touched.clear();
+        for(uint32_t m = members_offs[c]; m < members_offs[c+1]; m++) {
+            const uint32_t v = members[m];
+            ng.loop[c] += g.loop[v];
+            for(uint64_t i = g.offs[v]; i < g.offs[v+1]; i++) {
+                const uint32_t c2 = comm[g.adj[i]];
+                if (c2 == c) {
+                    ng.loop[c] += g.w[i];
+                    continue;
+                }
+                if (neigh_w[c2] < 0) {
+                    neigh_w[c2] = 0;
+                    touched.push_back(c2);
+                }
+                neigh_w[c2] += g.w[i];
+            }
+        }
+        for(const uint32_t c2: touched) {
+            ng.adj.push_back(c2);
+            ng.w.push_back(neigh_w[c2]);
+            neigh_w[c2] = -1.0;
+        }
+        ng.offs.push_back(ng.adj.size());
+    }
+    return ng;
+}
+
+double Louvain::calc_modularity(
+    const Graph& g, const vector<uint32_t>& comm, const uint32_t num_comms) const
+{
+    if (m2 == 0) return 0;
+    vector<double> in(num_comms, 0);
+    vector<double> tot(num_comms, 0);
+    for(uint32_t v = 0; v < g.size(); v++) {
+        in[comm[v]] += g.loop[v];
+        tot[comm[v]] += g.loop[v];
+        for(uint64_t i = g.offs[v]; i < g.offs[v+1]; i++) {
+            tot[comm[v]] += g.w[i];
+            if (comm[g.adj[i]] == comm[v]) in[comm[v]] += g.w[i];
+        }
+    }
+    double q = 0;
+    for(uint32_t c = 0; c < num_comms; c++) {
+        q += in[c]/m2 - (tot[c]/m2)*(tot[c]/m2);
+    }
+    return q;
+}
+
+vector<uint32_t> Louvain::compute(const uint32_t max_levels)
+{
+    const uint32_t n = graph.size();
+    vector<uint32_t> result(n);
+    for(uint32_t v = 0; v < n; v++) result[v] = v;
+    levels = 0;
+    final_modularity = 0;
+    if (m2 == 0) return result;
+
+    Graph g = std::move(graph);
+    vector<uint32_t> comm(n);
+    uint32_t num_comms = n;
+    while (levels < max_levels) {
+        comm.resize(g.size());
+        const bool moved = one_level(g, comm, num_comms);
+        for(auto& r: result) r = comm[r];
+        levels++;
+        if (!moved) break;
+        g = contract(g, comm, num_comms);
+    }
+    vector<uint32_t> identity(g.size());
+    for(uint32_t v = 0; v < g.size(); v++) identity[v] = v;
+    final_modularity = calc_modularity(g, identity, g.size());
+
+    neigh_w.clear();
+    neigh_w.shrink_to_fit();
+    touched.clear();
+    touched.shrink_to_fit();
+    return result;
+}
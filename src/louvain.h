@@ -0,0 +1,86 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace CMSat {
+
+using std::vector;
+
+/**
+@brief Multi-level Louvain community detection on a weighted undirected graph
+
+The graph is given as an edge list, which is merged into CSR form. Each level
+greedily moves vertices to the neighbouring community with the best modularity
+gain until nothing moves, then contracts every community into one vertex.
+Everything is flat arrays and linear per pass, so graphs with millions of
+vertices take seconds.
+*/
+class Louvain
+{
+public:
+    struct Edge {
+        uint32_t a;
+        uint32_t b;
+        float w;
+    };
+
+    ///Edges may repeat (weights add up), and a==b edges are ignored. The
+    ///list is consumed
+    Louvain(const uint32_t num_vertices, vector<Edge>& edges);
+
+    ///Community of each vertex, numbered from 0. Isolated vertices are
+    ///communities of their own
+    vector<uint32_t> compute(const uint32_t max_levels = 20);
+
+    uint32_t num_levels() const { return levels; }
+    double modularity() const { return final_modularity; }
+
+private:
+    struct Graph {
+        vector<uint64_t> offs;
+        vector<uint32_t> adj;
+        vector<double> w;
+        vector<double> loop; ///<Weight inside the vertex, counted twice
+        uint32_t size() const { return offs.size()-1; }
+    };
+
+    //Returns whether any vertex moved. comm[v] is numbered from 0 on return
+    bool one_level(const Graph& g, vector<uint32_t>& comm, uint32_t& num_comms);
+    Graph contract(const Graph& g, const vector<uint32_t>& comm, uint32_t num_comms);
+    double calc_modularity(const Graph& g, const vector<uint32_t>& comm, uint32_t num_comms) const;
+
+    Graph graph;
+    double m2 = 0; ///<Sum of all weighted degrees, twice the total edge weight
+    uint32_t levels = 0;
+    double final_modularity = 0;
+
+    //Neighbour-community weights of the vertex being moved
+    vector<double> neigh_w;
+    vector<uint32_t> touched;
+};
+
+}
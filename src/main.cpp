@@ -66,6 +66,17 @@ void Main::readInAFile(SATSolver* solver2, const string& filename) {
     std::unique_ptr<FieldGen> fg = std::make_unique<FGenDouble>();
     solver2->add_sql_tag("filename", filename);
     if (conf.verbosity) cout << "c Reading file '" << filename << "'" << endl;
+
+    // Plain (non-gzipped) regular files are parsed straight from a read-only
+    // mapping, without copying them through the chunked stream buffer
+    MMapFile mapped;
+    if (mapped.open(filename) && !mapped.is_gzip()) {
+        DimacsParser<StreamBuffer<MMapView, MM>, SATSolver> parser(solver2, &debugLib, conf.verbosity, fg);
+        if (!parser.parse_DIMACS(mapped.view(), false)) exit(-1);
+        return;
+    }
+    mapped.close();
+
     #ifndef USE_ZLIB
     FILE * in = fopen(filename.c_str(), "rb");
     DimacsParser<StreamBuffer<FILE*, FN>, SATSolver> parser(solver2, &debugLib, conf.verbosity, fg);
@@ -340,22 +351,25 @@ void Main::add_supported_options() {
     #endif
 
     #ifdef FINAL_PREDICTOR
-    po::options_description predictOptions("Predict options");
-    predictOptions.add_options()
     program.add_argument("--predloc")
-        .action([&](const auto& a) {conf.pred_conf_location = fc_int(a);})
+        .action([&](const auto& a) {conf.pred_conf_location = a;})
          .default_value(conf.pred_conf_location)
         .help("Directory where predictor_short.json, predictor_long.json, predictor_forever.json are");
     program.add_argument("--predtype")
-        .action([&](const auto& a) {conf.predictor_type = fc_int(a);})
+        .action([&](const auto& a) {conf.predictor_type = a;})
         .default_value(conf.predictor_type)
-        .help("Type of predictor. Supported: py, xgb, lgbm");
+        .help("Type of predictor. Supported: py, trees (built-in evaluator of the xgb"
+            " models), and xgb and lgbm if the libraries were found at build time");
+    program.add_argument("--predthreads")
+        .action([&](const auto& a) {conf.predictor_helper_threads = fc_int(a);})
+        .default_value(conf.predictor_helper_threads)
+        .help("Helper threads for the 'trees' predictor");
     program.add_argument("--predtables")
-        .action([&](const auto& a) {conf.pred_tables = fc_int(a);})
+        .action([&](const auto& a) {conf.pred_tables = a;})
         .default_value(conf.pred_tables)
         .help("000 = normal for all, 111 = ancestor for all");
     program.add_argument("--predbestfeats")
-         .action([&](const auto& a) {conf.predict_best_feat_fname = a);})
+         .action([&](const auto& a) {conf.predict_best_feat_fname = a;})
          .default_value(conf.predict_best_feat_fname)
         .help("Model python file name");
 
@@ -561,6 +575,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.sls_memoutMB = fc_int(a);})
         .default_value(conf.sls_memoutMB)
         .help("Maximum number of MB to give to SLS solver. Doesn't run SLS solver if the memory usage would be more than this.");
+    program.add_argument("--slsthreads")
+        .action([&](const auto& a) {conf.sls_walker_threads = fc_int(a);})
+        .default_value(conf.sls_walker_threads)
+        .help("Run this many CCNR walkers on background threads, alongside CDCL, instead of SLS in-line. They feed phases and variable bumps to the search");
     program.add_argument("--slseveryn")
         .action([&](const auto& a) {conf.sls_every_n = fc_int(a);})
         .default_value(conf.sls_every_n)
@@ -723,6 +741,19 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.subsume_gothrough_multip = fc_double(a);})
         .default_value(conf.subsume_gothrough_multip)
         .help("How many times go through subsume");
+    program.add_argument("--subthreads")
+        .action([&](const auto& a) {conf.subsume_helper_threads = fc_int(a);})
+        .default_value(conf.subsume_helper_threads)
+        .help("Helper threads for long-with-long subsumption. They look for the"
+            " subsumers of a batch of clauses with --subonewatch 1, and for the"
+            " subsumed clauses of a batch with --subonewatch 0. Removal stays"
+            " sequential, so the result is the same as without them. 0 = off");
+    program.add_argument("--subonewatch")
+        .action([&](const auto& a) {conf.subsume_one_watch = fc_int(a);})
+        .default_value(conf.subsume_one_watch)
+        .help("Subsume long clauses with long clauses via a one-watch forward subsumption"
+            " index instead of scanning occurrence lists backwards. Both use the"
+            " helper threads of --subthreads");
 
     /* po::options_description bva_options("BVA options"); */
     program.add_argument("--bva")
@@ -777,6 +808,13 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.varelim_check_resolvent_subs = fc_int(a);})
         .default_value(conf.varelim_check_resolvent_subs)
         .help("BVE should check whether resolvents subsume others and check for exact size increase");
+    program.add_argument("--varelimthreads")
+        .action([&](const auto& a) {conf.varelim_helper_threads = fc_int(a);})
+        .default_value(conf.varelim_helper_threads)
+        .help("Helper threads for BVE. Batches of variables whose neighbourhoods don't"
+            " overlap are tested in parallel by plain resolution, without gate detection"
+            " or weakening, then eliminated in order. Not used with --varelimcheckres 1."
+            " 0 = off");
 
     /* po::options_description xorOptions("XOR-related options"); */
     program.add_argument("--xor")
@@ -991,6 +1029,38 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.sync_every_confl = fc_ll(a);})
         .default_value(conf.sync_every_confl)
         .help("Sync threads every N conflicts");
+    program.add_argument("--sharelong")
+        .action([&](const auto& a) {conf.share_long_cls = fc_int(a);})
+        .default_value(conf.share_long_cls)
+        .help("Share short, low-glue learnt clauses between threads, not only units and binaries");
+    program.add_argument("--sharelongmaxsize")
+        .action([&](const auto& a) {conf.share_long_cls_max_size = fc_int(a);})
+        .default_value(conf.share_long_cls_max_size)
+        .help("Share learnt clauses between threads only if their size is at most this");
+    program.add_argument("--sharelongmaxglue")
+        .action([&](const auto& a) {conf.share_long_cls_max_glue = fc_int(a);})
+        .default_value(conf.share_long_cls_max_glue)
+        .help("Share learnt clauses between threads only if their glue is at most this");
+    program.add_argument("--cube")
+        .action([&](const auto& a) {conf.cube_and_conquer = fc_int(a);})
+        .default_value(conf.cube_and_conquer)
+        .help("With multiple threads, split the problem into cubes by lookahead and solve them with work-stealing, instead of portfolio solving");
+    program.add_argument("--cubeperthread")
+        .action([&](const auto& a) {conf.cube_init_per_thread = fc_int(a);})
+        .default_value(conf.cube_init_per_thread)
+        .help("Cube-and-conquer: create this many initial cubes per thread");
+    program.add_argument("--cubeconfl")
+        .action([&](const auto& a) {conf.cube_confl_budget = fc_ll(a);})
+        .default_value(conf.cube_confl_budget)
+        .help("Cube-and-conquer: split a cube further if it's not solved within this many conflicts");
+    program.add_argument("--cubemaxlen")
+        .action([&](const auto& a) {conf.cube_max_len = fc_int(a);})
+        .default_value(conf.cube_max_len)
+        .help("Cube-and-conquer: never split cubes longer than this, solve them to completion");
+    program.add_argument("--cubecands")
+        .action([&](const auto& a) {conf.cube_lookahead_cands = fc_int(a);})
+        .default_value(conf.cube_lookahead_cands)
+        .help("Cube-and-conquer: number of variables to look ahead on when splitting a cube");
     program.add_argument("--clearinter")
         .action([&](const auto& a) {need_clean_exit = fc_int(a);})
         .default_value(0)
@@ -1003,10 +1073,6 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.do_print_times = fc_int(a);})
         .default_value(conf.do_print_times)
         .help("Print time it took for each simplification run. If set to 0, logs are easier to compare");
-    program.add_argument("--maxsccdepth")
-        .action([&](const auto& a) {conf.max_scc_depth = fc_int(a);})
-        .default_value(conf.max_scc_depth)
-        .help("The maximum for scc search depth");
     program.add_argument("--sampling")
         .help("Set sampling vars such as '1,84,44'. Can also be set via CNF using 'c p show 1 84 44 0'");
     program.add_argument("--assump")
@@ -1038,6 +1104,16 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.gaussconf.max_num_matrices = fc_int(a);})
         .default_value(conf.gaussconf.max_num_matrices)
         .help("Maximum number of matrices to treat.");
+    program.add_argument("--gaussthreads")
+        .action([&](const auto& a) {conf.gaussconf.elim_helper_threads = fc_int(a);})
+        .default_value(conf.gaussconf.elim_helper_threads)
+        .help("Helper threads to xor rows in parallel when eliminating a column of a"
+            " large Gauss matrix. 0 = off");
+    program.add_argument("--gaussthreadsmin")
+        .action([&](const auto& a) {conf.gaussconf.elim_helper_min_words = fc_int(a);})
+        .default_value(conf.gaussconf.elim_helper_min_words)
+        .help("Only use the Gauss helper threads if a column elimination xors at"
+            " least this many 64b words");
     program.add_argument("--gaussusefulcutoff")
         .action([&](const auto& a) {conf.gaussconf.min_usefulness_cutoff = fc_double(a);})
         .default_value(conf.gaussconf.min_usefulness_cutoff)
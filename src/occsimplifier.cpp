@@ -1140,6 +1140,13 @@ bool OccSimplifier::eliminate_vars()
     assert(solver->watches.get_smudged_list().empty());
     bvestats.clear();
     bvestats.numCalls = 1;
+    velim_par_tested = 0;
+    velim_par_fallback = 0;
+    const bool par = solver->conf.varelim_helper_threads > 0
+        && !solver->conf.varelim_check_resolvent_subs;
+    if (par && !velim_helpers) {
+        velim_helpers = std::make_unique<HelperPool>(solver->conf.varelim_helper_threads);
+    }
 
     //Go through the ordered list of variables to eliminate
     int64_t last_elimed = 1;
@@ -1189,6 +1196,10 @@ bool OccSimplifier::eliminate_vars()
             ) {
                 assert(solver->prop_at_head());
                 assert(limit_to_decrease == &norm_varelim_time_limit);
+                if (par) {
+                    if (!eliminate_vars_batch(vars_elimed, last_elimed, wenThrough)) goto end;
+                    continue;
+                }
                 uint32_t var = velim_order.removeMin();
 
                 //Stats
@@ -1322,6 +1333,10 @@ end:
 
     verb_print(1, "#try to eliminate: "<< print_value_kilo_mega(wenThrough));
     verb_print(1, "#var-elim        : "<< print_value_kilo_mega(vars_elimed));
+    if (par) {
+        verb_print(1, "#par-tested      : "<< print_value_kilo_mega(velim_par_tested)
+            << " fallback: " << print_value_kilo_mega(velim_par_fallback));
+    }
     verb_print(1, "#T-o: " << (time_out ? "Y" : "N"));
     verb_print(1, "#T-r: " << std::fixed << std::setprecision(2) << (time_remain*100.0) << "%");
     verb_print(1, "#T  : " << time_used);
@@ -1565,6 +1580,241 @@ uint32_t OccSimplifier::add_cls_to_picosat_definable(const Lit wsLit) {
     return added;
 }
 
+/**
+@brief Eliminates a batch of variables, testing them on the helper threads
+
+Variables are taken in heap order, and one is only added to the batch if no
+variable of its neighbourhood (the variables of its irredundant clauses) is in
+the neighbourhood of one already added. The others go back to the heap.
+Eliminating a variable of the batch then can't change the clauses of another
+one: the resolvents only have variables of its own neighbourhood, so they can't
+subsume or strengthen a clause of the other. Only a propagated unit could, so
+once the trail grows, the rest of the batch is tested again here as usual.
+
+The helpers only read the clauses, and test by plain resolution with the same
+limits as test_elim_and_fill_resolvents(), but without gates or weakening.
+*/
+bool OccSimplifier::eliminate_vars_batch(
+    size_t& vars_elimed, int64_t& last_elimed, size_t& wenThrough)
+{
+    num_velim_jobs = 0;
+    velim_deferred.clear();
+    for(uint32_t looked = 0; looked < 1024
+        && !velim_order.empty()
+        && *limit_to_decrease > 0; looked++
+    ) {
+        const uint32_t var = velim_order.removeMin();
+        *limit_to_decrease -= 20;
+        if (!can_eliminate_var(var)) {
+            wenThrough++;
+            continue;
+        }
+        if (!mark_velim_neighbourhood(var)) {
+            velim_deferred.push_back(var);
+            continue;
+        }
+        wenThrough++;
+        if (velim_jobs.size() <= num_velim_jobs) velim_jobs.resize(num_velim_jobs+1);
+        velim_jobs[num_velim_jobs++].var = var;
+    }
+    for(const Lit l: toClear) seen[l.toInt()] = 0;
+    toClear.clear();
+    for(const uint32_t var: velim_deferred) velim_order.insert(var);
+
+    const uint32_t grow_by = grow;
+    velim_helpers->parallel_for(num_velim_jobs, [&](size_t b, size_t e) {
+        for(size_t i = b; i < e; i++) plain_resolvents(velim_jobs[i], grow_by);
+    });
+    velim_par_tested += num_velim_jobs;
+
+    const size_t trail_at = solver->trail_size();
+    for(size_t i = 0; i < num_velim_jobs; i++) {
+        VelimJob& job = velim_jobs[i];
+        if (*limit_to_decrease <= 0
+            || varelim_num_limit <= 0
+            || varelim_linkin_limit_bytes <= 0
+            || solver->must_interrupt_asap()
+        ) {
+            if (can_eliminate_var(job.var)) velim_order.insert(job.var);
+            continue;
+        }
+
+        bool elimed;
+        if (solver->trail_size() == trail_at) {
+            elimed = eliminate_by_job(job);
+        } else {
+            if (!can_eliminate_var(job.var)) continue;
+            velim_par_fallback++;
+            elimed = maybe_eliminate(job.var);
+        }
+        if (elimed) {
+            vars_elimed++;
+            varelim_num_limit--;
+            last_elimed++;
+        }
+        if (!solver->okay()) return false;
+        assert(solver->prop_at_head());
+
+        if (!clear_vars_from_cls_that_have_been_set()) return false;
+        if (!sub_str_with_added_long_and_bin(false)) return false;
+        assert(solver->okay());
+        assert(solver->prop_at_head());
+        update_varelim_complexity_heap();
+    }
+
+    return solver->okay();
+}
+
+//Marks the neighbourhood of "var" in seen[] unless it overlaps with one
+//already marked
+bool OccSimplifier::mark_velim_neighbourhood(const uint32_t var)
+{
+    for(int mark = 0; mark < 2; mark++) {
+        for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+            if (!mark) *limit_to_decrease -= (int64_t)solver->watches[lit].size();
+            for(const Watched& w: solver->watches[lit]) {
+                if (solver->redundant_or_removed(w)) continue;
+                const Clause* cl = w.isBin() ? nullptr : solver->cl_alloc.ptr(w.get_offset());
+                if (!mark && cl) *limit_to_decrease -= (int64_t)cl->size();
+                const uint32_t sz = cl ? cl->size() : 2;
+                for(uint32_t k = 0; k < sz; k++) {
+                    const Lit v = Lit((cl ? (*cl)[k] : (k ? w.lit2() : lit)).var(), false);
+                    if (!mark) {
+                        if (seen[v.toInt()]) return false;
+                    } else if (!seen[v.toInt()]) {
+                        seen[v.toInt()] = 1;
+                        toClear.push_back(v);
+                    }
+                }
+            }
+        }
+    }
+    if (!seen[Lit(var, false).toInt()]) {
+        seen[Lit(var, false).toInt()] = 1;
+        toClear.push_back(Lit(var, false));
+    }
+    return true;
+}
+
+//Runs on the helper threads, must only read
+void OccSimplifier::plain_resolvents(VelimJob& job, const uint32_t grow_by) const
+{
+    job.ok = false;
+    job.cost = 0;
+    job.res.clear();
+    const Lit lit(job.var, false);
+    for(const Lit l: {lit, ~lit}) {
+        vector<Watched>& out = (l == lit) ? job.poss : job.negs;
+        out.clear();
+        job.cost += (int64_t)solver->watches[l].size()*3 + 100;
+        for(const Watched& w: solver->watches[l]) {
+            if (solver->redundant_or_removed(w)) continue;
+            if (w.isBin() ? solver->value(w.lit2()) != l_Undef
+                : solver->satisfied(w.get_offset())) continue;
+            out.push_back(w);
+        }
+    }
+
+    //Pure literal, no resolvents
+    if (job.poss.empty() || job.negs.empty()) {
+        job.ok = true;
+        return;
+    }
+    if ((uint64_t)job.poss.size() * (uint64_t)job.negs.size()
+        >= solver->conf.varelim_cutoff_too_many_clauses
+    ) {
+        return;
+    }
+
+    const uint32_t limit = job.poss.size() + job.negs.size() + grow_by;
+    for(const Watched& pos: job.poss) {
+        for(const Watched& neg: job.negs) {
+            job.cost += 3;
+            if (!plain_resolve(pos, neg, lit, job.tmp, job.cost)) continue;
+            if (job.res.size() + 1 > limit
+                || (solver->conf.velim_resolvent_too_large != -1
+                    && (int)job.tmp.size() > solver->conf.velim_resolvent_too_large)
+            ) {
+                return;
+            }
+
+            ClauseStats stats;
+            if (pos.isBin() && neg.isClause()) {
+                stats = solver->cl_alloc.ptr(neg.get_offset())->stats;
+            } else if (neg.isBin() && pos.isClause()) {
+                stats = solver->cl_alloc.ptr(pos.get_offset())->stats;
+            } else if (neg.isClause() && pos.isClause()) {
+                stats = ClauseStats::combineStats(
+                    solver->cl_alloc.ptr(pos.get_offset())->stats,
+                    solver->cl_alloc.ptr(neg.get_offset())->stats);
+            }
+            job.res.add_resolvent(job.tmp, stats);
+        }
+    }
+    job.ok = true;
+}
+
+//Resolves on "lit" into "out" without seen[]. Returns false if the resolvent
+//is tautological or satisfied.
+bool OccSimplifier::plain_resolve(
+    const Watched& ps, const Watched& qs, const Lit lit,
+    vector<Lit>& out, int64_t& cost) const
+{
+    out.clear();
+    for(const Watched* w: {&ps, &qs}) {
+        const Lit pivot = (w == &ps) ? lit : ~lit;
+        if (w->isBin()) {
+            out.push_back(w->lit2());
+            continue;
+        }
+        for(const Lit l: *solver->cl_alloc.ptr(w->get_offset())) {
+            if (l != pivot) out.push_back(l);
+        }
+    }
+    cost += (int64_t)out.size();
+    std::sort(out.begin(), out.end());
+
+    //A literal and its negation are next to each other once sorted
+    uint32_t j = 0;
+    for(uint32_t i = 0; i < out.size(); i++) {
+        if (j > 0 && out[j-1] == out[i]) continue;
+        if (j > 0 && out[j-1] == ~out[i]) return false;
+        if (solver->value(out[i]) == l_True) return false;
+        out[j++] = out[i];
+    }
+    out.resize(j);
+    return true;
+}
+
+//Like maybe_eliminate(), with the resolvents a helper found
+bool OccSimplifier::eliminate_by_job(VelimJob& job)
+{
+    assert(solver->ok);
+    assert(solver->prop_at_head());
+    const uint32_t var = job.var;
+    assert(can_eliminate_var(var));
+
+    print_var_elim_complexity_stats(var);
+    bvestats.testedToElimVars++;
+    *limit_to_decrease -= job.cost;
+    if (!job.ok || *limit_to_decrease < 0) return false;
+    bvestats.triedToElimVars++;
+
+    const Lit lit = Lit(var, false);
+    print_var_eliminate_stat(lit);
+    create_dummy_elimed_clause(lit);
+    rem_cls_from_watch_due_to_varelim(lit);
+    rem_cls_from_watch_due_to_varelim(~lit);
+
+    while(!job.res.empty()) {
+        if (!add_varelim_resolvent(job.res.back_lits(), job.res.back_stats())) break;
+        job.res.pop();
+    }
+    set_var_as_eliminated(var);
+
+    return true;
+}
+
 bool OccSimplifier::elim_var_by_str(uint32_t var, const vector<pair<ClOffset, ClOffset>>& cls)
 {
     Lit l(var, false);
@@ -2616,10 +2866,10 @@ bool OccSimplifier::perform_ternary(Clause* cl, ClOffset offs, Sub1Ret& sub1_ret
     //Add new ternary resolvents
     for(const Tri& newcl: cl_to_add_ternary) {
         ClauseStats stats;
-        stats.last_touched_any = solver->sumConflicts;
         stats.is_ternary_resolvent = true;
-        #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         ClauseStatsExtra stats_extra;
+        stats_extra.last_touched_any = solver->sumConflicts;
+        #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         stats_extra.introduced_at_conflict = solver->sumConflicts;
         stats_extra.orig_size = 3;
         #endif
@@ -2646,10 +2896,7 @@ bool OccSimplifier::perform_ternary(Clause* cl, ClOffset offs, Sub1Ret& sub1_ret
                 (double)rnd_uint(solver->mtrand,100000)/100000.0  < solver->conf.lock_for_data_gen_ratio;
             if (newCl->stats.locked_for_data_gen) newCl->stats.which_red_array = 0;
             #endif
-            #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
-            solver->red_stats_extra.push_back(stats_extra);
-            newCl->stats.extra_pos = solver->red_stats_extra.size()-1;
-            #endif
+            solver->red_stats_extra[newCl->stats.extra_pos] = stats_extra;
             ClOffset off = solver->cl_alloc.get_offset(newCl);
             if (!sub_str->backw_sub_str_with_long(off, sub1_ret)) {
                 return false;
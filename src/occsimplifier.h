@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include <array>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <set>
@@ -34,6 +35,7 @@ THE SOFTWARE.
 #include "touchlist.h"
 #include "watched.h"
 #include "watcharray.h"
+#include "helperpool.h"
 struct PicoSAT;
 
 namespace CMSat {
@@ -487,6 +489,29 @@ private:
         vector<ClauseStats> cl_stats;
     };
     Resolvents resolvents;
+
+    //Parallel BVE, see eliminate_vars_batch()
+    struct VelimJob {
+        uint32_t var;
+        bool ok;
+        int64_t cost;
+        Resolvents res;
+        vector<Watched> poss;
+        vector<Watched> negs;
+        vector<Lit> tmp;
+    };
+    bool eliminate_vars_batch(size_t& vars_elimed, int64_t& last_elimed, size_t& wenThrough);
+    bool mark_velim_neighbourhood(const uint32_t var);
+    void plain_resolvents(VelimJob& job, const uint32_t grow_by) const;
+    bool plain_resolve(const Watched& ps, const Watched& qs, const Lit lit,
+        vector<Lit>& out, int64_t& cost) const;
+    bool eliminate_by_job(VelimJob& job);
+    std::unique_ptr<HelperPool> velim_helpers;
+    vector<VelimJob> velim_jobs;
+    size_t num_velim_jobs = 0;
+    vector<uint32_t> velim_deferred;
+    uint64_t velim_par_tested = 0;
+    uint64_t velim_par_fallback = 0;
     uint32_t calc_data_for_heuristic(const Lit lit);
     uint64_t time_spent_on_calc_otf_update;
     uint64_t num_otf_update_until_now;
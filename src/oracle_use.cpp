@@ -626,6 +626,9 @@ bool Solver::oracle_sparsify(bool fast)
                 litStats.redLits += cl->size();
                 longRedCls[2].push_back(off);
                 cl->stats.which_red_array = 2;
+                red_stats_extra.push_back(ClauseStatsExtra());
+                red_stats_extra.back().last_touched_any = sumConflicts;
+                cl->stats.extra_pos = red_stats_extra.size()-1;
                 cl->isRed = true;
             } else {
                 cl_alloc.clauseFree(off);
@@ -52,6 +52,63 @@ inline int scan_fwd_64b(uint64_t value)
 }
 #endif
 
+#ifdef USE_PACKEDROW_AVX2
+#include <immintrin.h>
+
+//Rows are [rhs][words...] and rows are only 16-byte aligned, so all
+//accesses are unaligned. The compiler is free to use AVX2 in these functions
+//only, callers check has_avx2 first.
+const bool CMSat::rowsimd::has_avx2 = __builtin_cpu_supports("avx2");
+
+__attribute__((target("avx2")))
+void CMSat::rowsimd::xor_avx2(int64_t* __restrict a, const int64_t* __restrict b, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        _mm256_storeu_si256((__m256i*)(a+i), _mm256_xor_si256(x, y));
+    }
+    for (; i < n; i++) a[i] ^= b[i];
+}
+
+__attribute__((target("avx2")))
+void CMSat::rowsimd::and_inv_avx2(int64_t* __restrict a, const int64_t* __restrict b, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        _mm256_storeu_si256((__m256i*)(a+i), _mm256_andnot_si256(y, x));
+    }
+    for (; i < n; i++) a[i] &= ~b[i];
+}
+
+__attribute__((target("avx2")))
+void CMSat::rowsimd::set_and_inv_avx2(int64_t* __restrict out, const int64_t* a, const int64_t* b, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        _mm256_storeu_si256((__m256i*)(out+i), _mm256_andnot_si256(y, x));
+    }
+    for (; i < n; i++) out[i] = a[i] & ~b[i];
+}
+
+__attribute__((target("avx2")))
+void CMSat::rowsimd::set_and_avx2(int64_t* __restrict out, const int64_t* a, const int64_t* b, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        _mm256_storeu_si256((__m256i*)(out+i), _mm256_and_si256(x, y));
+    }
+    for (; i < n; i++) out[i] = a[i] & b[i];
+}
+#endif
+
 ///returns popcnt
 uint32_t PackedRow::find_watchVar(
     vector<Lit>& tmp_clause,
@@ -37,6 +37,10 @@ THE SOFTWARE.
 #include "Vec.h"
 #include "xor.h"
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define USE_PACKEDROW_AVX2
+#endif
+
 namespace CMSat {
 
 using std::vector;
@@ -44,6 +48,20 @@ using std::vector;
 class PackedMatrix;
 class EGaussian;
 
+#ifdef USE_PACKEDROW_AVX2
+//Wide kernels for long rows, see packedrow.cpp. Rows shorter than
+//avx2_min_words 64b words, or CPUs without AVX2, use the scalar loops
+namespace rowsimd {
+    constexpr int avx2_min_words = 8;
+    extern const bool has_avx2;
+    void xor_avx2(int64_t* __restrict a, const int64_t* __restrict b, int n);
+    void and_inv_avx2(int64_t* __restrict a, const int64_t* __restrict b, int n);
+    void set_and_inv_avx2(int64_t* __restrict out, const int64_t* a, const int64_t* b, int n);
+    void set_and_avx2(int64_t* __restrict out, const int64_t* a, const int64_t* b, int n);
+    inline bool use_avx2(const int n) { return n >= avx2_min_words && has_avx2; }
+}
+#endif
+
 class PackedRow
 {
 public:
@@ -73,6 +91,12 @@ public:
         #endif
 
         //start from -1, because that's wher RHS is
+        #ifdef USE_PACKEDROW_AVX2
+        if (rowsimd::use_avx2(size+1)) {
+            rowsimd::xor_avx2(mp-1, b.mp-1, size+1);
+            return *this;
+        }
+        #endif
         for (int i = -1; i < size; i++) {
             *(mp + i) ^= *(b.mp + i);
         }
@@ -88,6 +112,12 @@ public:
         assert(b.size == size);
         #endif
 
+        #ifdef USE_PACKEDROW_AVX2
+        if (rowsimd::use_avx2(size)) {
+            rowsimd::and_inv_avx2(mp, b.mp, size);
+            return;
+        }
+        #endif
         for (int i = 0; i < size; i++) {
             *(mp + i) &= ~(*(b.mp + i));
         }
@@ -101,6 +131,12 @@ public:
         assert(b.size == size);
         #endif
 
+        #ifdef USE_PACKEDROW_AVX2
+        if (rowsimd::use_avx2(size)) {
+            rowsimd::set_and_inv_avx2(mp, a.mp, b.mp, size);
+            return;
+        }
+        #endif
         for (int i = 0; i < size; i++) {
             *(mp + i) = *(a.mp + i) & (~(*(b.mp + i)));
         }
@@ -114,6 +150,12 @@ public:
         assert(b.size == size);
         #endif
 
+        #ifdef USE_PACKEDROW_AVX2
+        if (rowsimd::use_avx2(size)) {
+            rowsimd::set_and_avx2(mp, a.mp, b.mp, size);
+            return;
+        }
+        #endif
         for (int i = 0; i < size; i++) {
             *(mp + i) = *(a.mp + i) & *(b.mp + i);
         }
@@ -145,6 +187,12 @@ public:
         #endif
 
         rhs_internal ^= b.rhs_internal;
+        #ifdef USE_PACKEDROW_AVX2
+        if (rowsimd::use_avx2(size)) {
+            rowsimd::xor_avx2(mp, b.mp, size);
+            return;
+        }
+        #endif
         for (int i = 0; i < size; i++) {
             *(mp + i) ^= *(b.mp + i);
         }
@@ -214,6 +262,19 @@ public:
         }
     }
 
+    ///Index of the first '1' at or after bit 'from', or UINT32_MAX if none
+    inline uint32_t find_next_one(const uint32_t from) const
+    {
+        int i = from/64;
+        if (i >= size) return numeric_limits<uint32_t>::max();
+        uint64_t bits = (uint64_t)mp[i] & (~0ULL << (from%64));
+        while (bits == 0) {
+            if (++i == size) return numeric_limits<uint32_t>::max();
+            bits = mp[i];
+        }
+        return i*64 + __builtin_ctzll(bits);
+    }
+
     inline bool operator[](const uint32_t i) const
     {
         #ifdef DEBUG_ROW
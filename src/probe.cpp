@@ -238,3 +238,93 @@ lbool Solver::probe_outside(Lit l, uint32_t& min_props)
     if (!okay()) return l_False;
     return l_Undef;
 }
+
+//Enqueues the cube (and "extra", if set) at decision level 1 and propagates.
+//Returns false on conflict. The caller must cancelUntil_light() afterwards.
+bool Solver::lookahead_assume(const vector<Lit>& cube, const Lit extra)
+{
+    new_decision_level();
+    for(const Lit l: cube) {
+        if (value(l) == l_False) return false;
+        if (value(l) == l_Undef) enqueue_light(l);
+    }
+    if (extra != lit_Undef) {
+        if (value(extra) == l_False) return false;
+        if (value(extra) == l_Undef) enqueue_light(extra);
+    }
+    return propagate_light<false>().isnullptr();
+}
+
+//Picks the variable to split "cube" (outer numbering) on, march-style: the
+//most-watched free variables under the cube are probed both ways, and the one
+//maximising the product of the two propagation counts wins. Returns lit_Error
+//if the cube is refuted by propagation, lit_Undef if there is nothing left to
+//split on, otherwise the positive outer literal of the variable picked.
+Lit Solver::lookahead_split_lit(const vector<Lit>& cube)
+{
+    assert(decisionLevel() == 0);
+    if (!okay()) return lit_Error;
+    assert(prop_at_head());
+
+    vector<Lit> cube_inter;
+    for(Lit l: cube) {
+        assert(l.var() < nVarsOuter());
+        l = varReplacer->get_lit_replaced_with_outer(l);
+        l = map_outer_to_inter(l);
+        //Eliminated, the solver will have to deal with it when assumed
+        if (varData[l.var()].removed != Removed::none) continue;
+        cube_inter.push_back(l);
+    }
+
+    vector<uint32_t> cands;
+    const bool cube_ok = lookahead_assume(cube_inter, lit_Undef);
+    const size_t base = trail.size();
+    if (cube_ok) {
+        for(uint32_t v = 0; v < nVars(); v++) {
+            if (value(v) == l_Undef
+                && varData[v].removed == Removed::none
+                && !varData[v].is_bva
+            ) {
+                cands.push_back(v);
+            }
+        }
+    }
+    cancelUntil_light();
+    if (!cube_ok) return lit_Error;
+    if (cands.empty()) return lit_Undef;
+
+    if (cands.size() > conf.cube_lookahead_cands) {
+        const auto occ = [&](const uint32_t v) {
+            return watches[Lit(v, false)].size() + watches[Lit(v, true)].size();
+        };
+        std::nth_element(cands.begin(), cands.begin() + conf.cube_lookahead_cands, cands.end(),
+            [&](const uint32_t a, const uint32_t b) { return occ(a) > occ(b); });
+        cands.resize(conf.cube_lookahead_cands);
+    }
+
+    Lit best = lit_Undef;
+    uint64_t best_score = 0;
+    for(const uint32_t v: cands) {
+        uint64_t props[2];
+        uint32_t failed = 0;
+        for(uint32_t sign = 0; sign < 2; sign++) {
+            if (lookahead_assume(cube_inter, Lit(v, sign))) {
+                props[sign] = trail.size() - base;
+            } else {
+                //Failed literal under the cube: one side of the split is free
+                props[sign] = nVars();
+                failed++;
+            }
+            cancelUntil_light();
+        }
+        if (failed == 2) return lit_Error;
+
+        const uint64_t score = (props[0]+1)*(props[1]+1);
+        if (best == lit_Undef || score > best_score) {
+            best = Lit(v, false);
+            best_score = score;
+        }
+    }
+
+    return map_inter_to_outer(best);
+}
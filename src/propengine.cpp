@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "watchalgos.h"
 #include "sqlstats.h"
 #include "gaussian.h"
+#include "helperpool.h"
 
 using namespace CMSat;
 using std::cout;
@@ -658,7 +659,7 @@ bool PropEngine::prop_long_cl_any_order(
         if (!inprocess) {
             #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
             c.stats.props_made++;
-            c.stats.last_touched_any = sumConflicts;
+            if (c.red()) red_stats_extra[c.stats.extra_pos].last_touched_any = sumConflicts;
             #endif
         }
 
@@ -727,6 +728,9 @@ void CMSat::PropEngine::reverse_prop(const CMSat::Lit l)
     varData[l.var()].propagated = false;
 }
 
+//How many watches ahead the clause of a long watch is prefetched
+static constexpr size_t prop_prefetch_distance = 2;
+
 template<bool inprocess, bool red_also, bool distill_use>
 PropBy PropEngine::propagate_any_order()
 {
@@ -747,13 +751,37 @@ PropBy PropEngine::propagate_any_order()
         }
         propStats.propagations++;
         simpDB_props--;
+
+        // Binaries are kept at the front of the watchlist, so they are
+        // propagated first, in a tight loop that never moves watches
+        for (; i != end && i->isBin(); i++) {
+            if (!red_also && i->red()) continue;
+            if (distill_use && i->bin_cl_marked()) continue;
+            prop_bin_cl<inprocess>(i, p, confl, currLevel);
+        }
+        j = i;
+        Watched* bin_end = i;
+
         for (; i != end; i++) {
-            // propagate binary clause
-            if (likely(i->isBin())) {
-                *j++ = *i;
-                if (!red_also && i->red()) continue;
-                if (distill_use && i->bin_cl_marked()) continue;
-                prop_bin_cl<inprocess>(i, p, confl, currLevel);
+            // Pull in the clause we are likely to have to visit soon. Most
+            // long clauses are short, so the line holding the first literals
+            // usually also holds the rest, plus the size and flags before them
+            Watched* const ahead = i + prop_prefetch_distance;
+            if (ahead < end && ahead->isClause()
+                && value(ahead->getBlockedLit()) != l_True
+            ) {
+                cmsat_prefetch(cl_alloc.ptr(ahead->get_offset())->getData());
+            }
+
+            // binary attached after long/BNN watches: propagate it and
+            // swap it into the binary prefix, so next time it's found early
+            if (i->isBin()) {
+                const Watched w = *i;
+                *j++ = *bin_end;
+                *bin_end++ = w;
+                if (!red_also && w.red()) continue;
+                if (distill_use && w.bin_cl_marked()) continue;
+                prop_bin_cl<inprocess>(&w, p, confl, currLevel);
                 continue;
             }
 
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <stack>
 #include <set>
 #include <cmath>
+#include <memory>
 
 #include "constants.h"
 #include "frat.h"
@@ -65,6 +66,7 @@ class Solver;
 class ClauseAllocator;
 class Gaussian;
 class EGaussian;
+class HelperPool;
 
 enum PropResult {
     PROP_FAIL = 0
@@ -240,7 +242,8 @@ public:
         {}
     };
     ///activity-ordered heap of decision variables.
-    Heap<VarOrderLt> order_heap_vsids; ///NOT VALID WHILE SIMPLIFYING
+    static constexpr int vsids_heap_arity = 4;
+    Heap<VarOrderLt, vsids_heap_arity> order_heap_vsids; ///NOT VALID WHILE SIMPLIFYING
     RandHeap order_heap_rand;
     Queue vmtf_queue;
     uint64_t stats_bumped = 0;
@@ -260,6 +263,7 @@ public:
     enum class gauss_ret {g_cont, g_nothing, g_false};
     vector<EGaussian*> gmatrices;
     vector<GaussQData> gqueuedata;
+    std::unique_ptr<HelperPool> gauss_helpers; ///<Created on first big enough eliminate_col
     // Scratch list of matrix indices touched during a single gauss_jordan_elim
     // call. Allows per-call bookkeeping to skip the many untouched matrices.
     vec<uint32_t> touched_matrices_gje;
@@ -26,9 +26,14 @@ THE SOFTWARE.
 #include "solverconf.h"
 #include "sqlstats.h"
 #ifdef FINAL_PREDICTOR
+#ifdef PREDICTOR_XGB
 #include "cl_predictors_xgb.h"
+#endif
+#ifdef PREDICTOR_LGBM
 #include "cl_predictors_lgbm.h"
+#endif
 #include "cl_predictors_py.h"
+#include "cl_predictors_trees.h"
 #endif
 
 // #define VERBOSE_DEBUG
@@ -155,8 +160,8 @@ void ReduceDB::sort_red_cls(ClauseClean clean_type)
     for(const auto& x: solver->longRedCls[2]) {
         const ClOffset offset = x;
         Clause* cl = solver->cl_alloc.ptr(offset);
-        cout << i << " offset: " << offset << " cl->stats.last_touched_any: " << cl->stats.last_touched_any
-        << " act:" << std::setprecision(9) << cl->stats.activity
+        cout << i << " offset: " << offset << " last_touched_any: " << solver->red_stats_extra[cl->stats.extra_pos].last_touched_any
+        << " act:" << std::setprecision(9) << solver->red_stats_extra[cl->stats.extra_pos].activity
         << " which_red_array:" << cl->stats.which_red_array << endl
         << " -- cl:" << *cl << " tern:" << cl->stats.is_ternary_resolvent
         << endl;
@@ -175,7 +180,9 @@ void ReduceDB::sort_red_cls(ClauseClean clean_type)
         case ClauseClean::activity : {
             std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(),
                 [this](const ClOffset x, const ClOffset y) {
-                    return solver->cl_alloc.ptr(x)->stats.activity > solver->cl_alloc.ptr(y)->stats.activity;
+                    const auto& extra = solver->red_stats_extra;
+                    return extra[solver->cl_alloc.ptr(x)->stats.extra_pos].activity
+                        > extra[solver->cl_alloc.ptr(y)->stats.extra_pos].activity;
                 });
             break;
         }
@@ -220,6 +227,7 @@ void ReduceDB::handle_lev2()
         solver->free_cl(offset);
     }
     delayed_clause_free.clear();
+    compact_red_stats_extra();
 
     #ifdef SLOW_DEBUG
     solver->check_no_removed_or_freed_cl_in_watch();
@@ -362,7 +370,7 @@ void ReduceDB::prepare_features(vector<ClOffset>& all_learnt)
         ClOffset offs = all_learnt[i];
         Clause* cl = solver->cl_alloc.ptr(offs);
         dat[i].pos = i;
-        dat[i].val = cl->stats.activity;
+        dat[i].val = solver->red_stats_extra[cl->stats.extra_pos].activity;
     }
     std::sort(dat.begin(), dat.end(), [](const val_and_pos& a, const val_and_pos& b) {
         return a.val > b.val;
@@ -377,12 +385,13 @@ void ReduceDB::prepare_features(vector<ClOffset>& all_learnt)
         cl->stats.extra_pos = new_extra_pos;
         new_extra_pos++;
     }
+    std::swap(solver->red_stats_extra, new_red_stats_extra);
     if (all_learnt.empty()) {
         median_data.median_act = 0;
     } else {
-        median_data.median_act = get_median_stat_dat(all_learnt, dat).activity;
+        uint32_t extra_at = get_median_stat_dat(all_learnt, dat).extra_pos;
+        median_data.median_act = solver->red_stats_extra[extra_at].activity;
     }
-    std::swap(solver->red_stats_extra, new_red_stats_extra);
 }
 #endif
 
@@ -494,8 +503,8 @@ void ReduceDB::handle_lev1()
         const ClOffset offset = solver->longRedCls[1][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
         #ifdef VERBOSE_DEBUG
-        cout << "offset: " << offset << " cl->stats.last_touched_any: " << cl->stats.last_touched_any
-        << " act:" << std::setprecision(9) << cl->stats.activity
+        cout << "offset: " << offset << " last_touched_any: " << solver->red_stats_extra[cl->stats.extra_pos].last_touched_any
+        << " act:" << std::setprecision(9) << solver->red_stats_extra[cl->stats.extra_pos].activity
         << " which_red_array:" << cl->stats.which_red_array << endl
         << " -- cl:" << *cl << " tern:" << cl->stats.is_ternary_resolvent
         << endl;
@@ -512,8 +521,9 @@ void ReduceDB::handle_lev1()
             if (cl->stats.is_ternary_resolvent) {
                 must_touch *= solver->conf.ternary_keep_mult; //this multiplier is 6 by default
             }
+            auto& stats_extra = solver->red_stats_extra[cl->stats.extra_pos];
             if (!solver->clause_locked(*cl, offset)
-                && cl->stats.last_touched_any + must_touch < solver->sumConflicts
+                && stats_extra.last_touched_any + must_touch < solver->sumConflicts
             ) {
                 solver->longRedCls[2].push_back(offset);
                 cl->stats.which_red_array = 2;
@@ -522,7 +532,7 @@ void ReduceDB::handle_lev1()
                 //across all clauses
                 //WARNING this changes the way things behave during STATS relative to non-STATS!
                 #ifndef STATS_NEEDED
-                cl->stats.activity = 0;
+                stats_extra.activity = 0;
                 solver->bump_cl_act<false>(cl);
                 #endif
                 non_recent_use++;
@@ -961,7 +971,7 @@ void ReduceDB::dump_pred_distrib(const vector<ClOffset>& offs, uint32_t lev) {
     if (!solver->conf.dump_pred_distrib) {
         return;
     }
-    std::ofstream distrib_file("pred_distrib.csv", ios::app);
+    std::ofstream distrib_file("pred_distrib.csv", std::ios::app);
     for(const auto& off:offs) {
         Clause* cl = solver->cl_alloc.ptr(off);
         ClauseStatsExtra& stats_extra = solver->red_stats_extra[cl->stats.extra_pos];
@@ -992,14 +1002,27 @@ void ReduceDB::handle_predictors()
     }
     num_times_pred_called++;
     if (predictors == nullptr) {
-        if (solver->conf.predictor_type == "xgb") {
-            predictors = new ClPredictorsXGB;
-        } else if (solver->conf.predictor_type == "lgbm") {
-            predictors = new ClPredictorsLGBM;
-        } else if (solver->conf.predictor_type == "py") {
-            predictors = new ClPredictorsPy;
-        } else {
-            cout << "ERROR: You must give either lgbm or xgboost for predictor" << endl;
+        const string& type = solver->conf.predictor_type;
+        #ifdef PREDICTOR_XGB
+        if (type == "xgb") predictors = new ClPredictorsXGB;
+        #endif
+        #ifdef PREDICTOR_LGBM
+        if (type == "lgbm") predictors = new ClPredictorsLGBM;
+        #endif
+        if (type == "py") predictors = new ClPredictorsPy;
+        if (type == "trees") {
+            predictors = new ClPredictorsTrees(solver->conf.predictor_helper_threads);
+        }
+        if (predictors == nullptr) {
+            cout << "ERROR: predictor type '" << type << "' is not available."
+            << " This build supports: py, trees"
+            #ifdef PREDICTOR_XGB
+            << ", xgb"
+            #endif
+            #ifdef PREDICTOR_LGBM
+            << ", lgbm"
+            #endif
+            << endl;
             exit(-1);
         }
         if (solver->conf.pred_conf_location.empty()) {
@@ -1023,7 +1046,8 @@ void ReduceDB::handle_predictors()
                 + (solver->conf.pred_tables[i] == '0' ? "used_later" : "used_later_anc")
                 + "-"
                 + tiers[i] + "-"
-                + solver->conf.predictor_type
+                //The built-in evaluator reads the xgboost models
+                + (solver->conf.predictor_type == "trees" ? "xgb" : solver->conf.predictor_type)
                 + std::string(".json"));
             }
 
@@ -1161,8 +1185,8 @@ void ReduceDB::mark_top_N_clauses_lev2(const uint64_t keep_num)
         const ClOffset offset = solver->longRedCls[2][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
         #ifdef VERBOSE_DEBUG
-        cout << "offset: " << offset << " cl->stats.last_touched_any: " << cl->stats.last_touched_any
-        << " act:" << std::setprecision(9) << cl->stats.activity
+        cout << "offset: " << offset << " last_touched_any: " << solver->red_stats_extra[cl->stats.extra_pos].last_touched_any
+        << " act:" << std::setprecision(9) << solver->red_stats_extra[cl->stats.extra_pos].activity
         << " which_red_array:" << cl->stats.which_red_array << endl
         << " -- cl:" << *cl << " tern:" << cl->stats.is_ternary_resolvent
         << endl;
@@ -1241,8 +1265,8 @@ void ReduceDB::remove_cl_from_lev2() {
         *solver->frat << del << *cl << fin;
         cl->set_removed();
         #ifdef VERBOSE_DEBUG
-        cout << "REMOVING offset: " << offset << " cl->stats.last_touched_any: " << cl->stats.last_touched_any
-        << " act:" << std::setprecision(9) << cl->stats.activity
+        cout << "REMOVING offset: " << offset << " last_touched_any: " << solver->red_stats_extra[cl->stats.extra_pos].last_touched_any
+        << " act:" << std::setprecision(9) << solver->red_stats_extra[cl->stats.extra_pos].activity
         << " which_red_array:" << cl->stats.which_red_array << endl
         << " -- cl:" << *cl << " tern:" << cl->stats.is_ternary_resolvent
         << endl;
@@ -1252,6 +1276,21 @@ void ReduceDB::remove_cl_from_lev2() {
     solver->longRedCls[2].resize(j);
 }
 
+//Drops the entries of the freed clauses. Every redundant clause is in one
+//of the tiers at this point.
+void ReduceDB::compact_red_stats_extra()
+{
+    vector<ClauseStatsExtra> new_red_stats_extra;
+    for(const auto& cls: solver->longRedCls) {
+        for(const ClOffset offs: cls) {
+            Clause* cl = solver->cl_alloc.ptr(offs);
+            new_red_stats_extra.push_back(solver->red_stats_extra[cl->stats.extra_pos]);
+            cl->stats.extra_pos = new_red_stats_extra.size()-1;
+        }
+    }
+    std::swap(solver->red_stats_extra, new_red_stats_extra);
+}
+
 ReduceDB::ClauseStats ReduceDB::ClauseStats::operator += (const ClauseStats& other)
 {
     total_uip1_used += other.total_uip1_used;
@@ -95,6 +95,7 @@ private:
 
     bool cl_needs_removal(const Clause* cl, const ClOffset offset) const;
     void remove_cl_from_lev2();
+    void compact_red_stats_extra();
 
     void sort_red_cls(ClauseClean clean_type);
     void mark_top_N_clauses_lev2(const uint64_t keep_num);
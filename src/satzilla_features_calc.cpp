@@ -295,13 +295,16 @@ void SatZillaFeaturesCalc::calculate_cl_distributions(
 
     //Calculate means
     double cla_inc = solver->get_cla_inc();
+    auto red_activity = [&](const Clause& cl) -> float {
+        return cl.red() ? solver->red_stats_extra[cl.stats.extra_pos].activity : 0;
+    };
     for(ClOffset off: clauses)
     {
         const Clause& cl = *solver->cl_alloc.ptr(off);
         size_mean += cl.size();
         glue_mean += cl.stats.glue;
         if (cl.red()) {
-            activity_mean += (double)cl.stats.activity/cla_inc;
+            activity_mean += (double)red_activity(cl)/cla_inc;
         }
     }
     size_mean /= clauses.size();
@@ -314,7 +317,7 @@ void SatZillaFeaturesCalc::calculate_cl_distributions(
         const Clause& cl = *solver->cl_alloc.ptr(off);
         size_var += std::pow(size_mean-cl.size(), 2);
         glue_var += std::pow(glue_mean-cl.stats.glue, 2);
-        activity_var += std::pow(activity_mean-(double)cl.stats.activity/cla_inc, 2);
+        activity_var += std::pow(activity_mean-(double)red_activity(cl)/cla_inc, 2);
     }
     size_var /= clauses.size();
     glue_var /= clauses.size();
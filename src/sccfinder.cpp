@@ -44,7 +44,6 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     assert(binxors.empty());
     runStats.clear();
     runStats.numCalls = 1;
-    depth_warning_issued = false;
     const double my_time = cpu_time();
 
     const uint32_t num_lits = solver->nVars() * 2;
@@ -54,18 +53,17 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     index.assign(num_lits, unset);
     lowlink.assign(num_lits, unset);
     stackIndicator.assign(num_lits, 0);
+    var_in_scc.assign(solver->nVars(), 0);
     assert(stack.empty());
+    assert(call_stack.empty());
 
-    depth = 0;
     for (uint32_t vertex = 0; vertex < num_lits; vertex++) {
         //Start a DFS at each node we haven't visited yet
         if (solver->value(Lit::toLit(vertex).var()) != l_Undef) {
             continue;
         }
-        assert(depth == 0);
         if (index[vertex] == unset) {
             tarjan(vertex);
-            depth--;
             assert(stack.empty());
         }
     }
@@ -88,20 +86,11 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     return solver->okay();
 }
 
-void SCCFinder::tarjan(const uint32_t vertex)
+bool SCCFinder::visit(const uint32_t vertex)
 {
-    depth++;
-    if (depth >= (uint32_t)solver->conf.max_scc_depth) {
-        if (solver->conf.verbosity && !depth_warning_issued) {
-            depth_warning_issued = true;
-            verb_print(1, "[scc] WARNING: reached maximum depth of " << solver->conf.max_scc_depth);
-        }
-        return;
-    }
-
     const Lit vertLit = Lit::toLit(vertex);
     if (solver->varData[vertLit.var()].removed != Removed::none) {
-        return;
+        return false;
     }
 
     runStats.bogoprops += 1;
@@ -110,49 +99,93 @@ void SCCFinder::tarjan(const uint32_t vertex)
     globalIndex++;
     stack.push(vertex); // Push v on the stack
     stackIndicator[vertex] = true;
+    call_stack.push_back(Frame{vertex, 0});
+    runStats.bogoprops += solver->watches[~vertLit].size()/4;
+    return true;
+}
 
-    //Go through the watch
-    watch_subarray_const ws = solver->watches[~vertLit];
-    runStats.bogoprops += ws.size()/4;
-    for (const Watched& w: ws) {
-        //Only binary clauses matter
-        if (!w.isBin())
-            continue;
+//Tarjan's algorithm with an explicit stack in place of recursion, so
+//implication chains of any length are fine
+void SCCFinder::tarjan(const uint32_t root)
+{
+    if (!visit(root)) return;
+
+    while (!call_stack.empty()) {
+        Frame& f = call_stack.back();
+        const uint32_t vertex = f.vertex;
+
+        //Go through the watch, from where we left off
+        watch_subarray_const ws = solver->watches[~Lit::toLit(vertex)];
+        bool descended = false;
+        while (f.at < ws.size()) {
+            const Watched& w = ws[f.at++];
+            //Only binary clauses matter
+            if (!w.isBin())
+                continue;
+
+            const Lit lit = w.lit2();
+            if (solver->value(lit) != l_Undef) {
+                continue;
+            }
+
+            const uint32_t v_prime = lit.toInt();
+            // Was successor v' visited?
+            if (index[v_prime] == numeric_limits<uint32_t>::max()) {
+                //Continues at the watch of v', 'f' is invalid from here
+                if (visit(v_prime)) {
+                    descended = true;
+                    break;
+                }
+            } else if (stackIndicator[v_prime]) {
+                lowlink[vertex] = std::min(lowlink[vertex], lowlink[v_prime]);
+            }
+        }
+        if (descended) continue;
 
-        const Lit lit = w.lit2();
-        if (solver->value(lit) != l_Undef) {
-            continue;
+        //All successors done, return to the caller
+        call_stack.pop_back();
+        if (!call_stack.empty()) {
+            const uint32_t parent = call_stack.back().vertex;
+            lowlink[parent] = std::min(lowlink[parent], lowlink[vertex]);
         }
-        doit(lit, vertex);
-    }
 
-    // Is v the root of an SCC?
-    if (lowlink[vertex] == index[vertex]) {
-        uint32_t vprime;
-        tmp.clear();
-        do {
-            assert(!stack.empty());
-            vprime = stack.top();
-            stack.pop();
-            stackIndicator[vprime] = false;
-            tmp.push_back(vprime);
-        } while (vprime != vertex);
-        if (tmp.size() >= 2) {
-            runStats.bogoprops += 3;
-            add_bin_xor_in_tmp();
+        // Is v the root of an SCC?
+        if (lowlink[vertex] == index[vertex]) {
+            uint32_t vprime;
+            tmp.clear();
+            do {
+                assert(!stack.empty());
+                vprime = stack.top();
+                stack.pop();
+                stackIndicator[vprime] = false;
+                tmp.push_back(vprime);
+            } while (vprime != vertex);
+            if (tmp.size() >= 2) {
+                runStats.bogoprops += 3;
+                add_bin_xor_in_tmp();
+            }
         }
     }
 }
 
 void SCCFinder::add_bin_xor_in_tmp()
 {
+    //The negated literals form an SCC too, with the same equivalences.
+    //Only the first of the pair found is kept
+    if (var_in_scc[Lit::toLit(tmp[0]).var()]) {
+        return;
+    }
+    for(const uint32_t x: tmp) {
+        var_in_scc[Lit::toLit(x).var()] = 1;
+    }
+
     const Lit head = Lit::toLit(tmp[0]);
     for (uint32_t i = 1; i < tmp.size(); i++) {
         const Lit other = Lit::toLit(tmp[i]);
         const bool rhs = head.sign() ^ other.sign();
 
         BinaryXor binxor(head.var(), other.var(), rhs);
-        binxors.insert(binxor);
+        binxors.push_back(binxor);
 
         //Both are UNDEF, so this is a proper binary XOR
         if (solver->value(binxor.vars[0]) == l_Undef
@@ -196,6 +229,9 @@ size_t SCCFinder::mem_used() const
     mem += stack.size()*sizeof(uint32_t); //TODO under-estimates
     mem += stackIndicator.capacity()*sizeof(char);
     mem += tmp.capacity()*sizeof(uint32_t);
+    mem += var_in_scc.capacity()*sizeof(char);
+    mem += call_stack.capacity()*sizeof(Frame);
+    mem += binxors.capacity()*sizeof(BinaryXor);
 
     return mem;
 }
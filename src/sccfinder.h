@@ -25,7 +25,6 @@ THE SOFTWARE.
 
 #include "clause.h"
 #include <stack>
-#include <set>
 
 namespace CMSat {
 
@@ -35,7 +34,8 @@ class SCCFinder {
     public:
         explicit SCCFinder(Solver* _solver);
         bool performSCC(uint64_t* bogoprops_given = nullptr);
-        const std::set<BinaryXor>& get_binxors() const;
+        ///Each equivalence once, in the order found
+        const vector<BinaryXor>& get_binxors() const;
         size_t get_num_binxors_found() const;
         void clear_binxors();
 
@@ -98,12 +98,10 @@ class SCCFinder {
 
         const Stats& get_stats() const;
         size_t mem_used() const;
-        bool depth_warning_triggered() const;
 
     private:
-        void tarjan(const uint32_t vertex);
-        bool depth_warning_issued = false;
-        void doit(const Lit lit, const uint32_t vertex);
+        void tarjan(const uint32_t root);
+        bool visit(const uint32_t vertex);
         void add_bin_xor_in_tmp();
 
         //temporaries
@@ -113,39 +111,29 @@ class SCCFinder {
         std::stack<uint32_t, vector<uint32_t> > stack;
         vector<char> stackIndicator;
         vector<uint32_t> tmp;
-        uint32_t depth = 0;
+        vector<char> var_in_scc;
+
+        //DFS position: vertex, and where we are in its watchlist
+        struct Frame {
+            uint32_t vertex;
+            uint32_t at;
+        };
+        vector<Frame> call_stack;
 
         Solver* solver;
-        std::set<BinaryXor> binxors;
+        vector<BinaryXor> binxors;
 
         //Stats
         Stats runStats;
         Stats globalStats;
 };
 
-inline void SCCFinder::doit(const Lit lit, const uint32_t vertex) {
-    const uint32_t v_prime = lit.toInt();
-    // Was successor v' visited?
-    if (index[v_prime] == numeric_limits<uint32_t>::max()) {
-        tarjan(v_prime);
-        depth--;
-        lowlink[vertex] = std::min(lowlink[vertex], lowlink[v_prime]);
-    } else if (stackIndicator[v_prime]) {
-        lowlink[vertex] = std::min(lowlink[vertex], lowlink[v_prime]);
-    }
-}
-
-inline bool SCCFinder::depth_warning_triggered() const
-{
-    return depth_warning_issued;
-}
-
 inline const SCCFinder::Stats& SCCFinder::get_stats() const
 {
     return globalStats;
 }
 
-inline const std::set<BinaryXor>& SCCFinder::get_binxors() const
+inline const vector<BinaryXor>& SCCFinder::get_binxors() const
 {
     return binxors;
 }
@@ -54,6 +54,7 @@ THE SOFTWARE.
 #include "str_impl_w_impl.h"
 #include "subsumeimplicit.h"
 #include "sls.h"
+#include "sls_walkers.h"
 #ifdef USE_VALGRIND
 #include "valgrind/valgrind.h"
 #include "valgrind/memcheck.h"
@@ -451,7 +452,7 @@ void Searcher::add_lits_to_learnt(
                 #if !defined(STATS_NEEDED) && !defined(FINAL_PREDICTOR)
                 if (cl->stats.which_red_array == 1)
                 #endif
-                    cl->stats.last_touched_any = sumConflicts;
+                    red_stats_extra[cl->stats.extra_pos].last_touched_any = sumConflicts;
 
                 //If stats or predictor, bump all because during final
                 //we will need this data and during dump when stats is on
@@ -1651,17 +1652,15 @@ Clause* Searcher::handle_last_confl(
     if (learnt_clause.size() <= 2) {
         cl = nullptr;
     } else {
-        cl = cl_alloc.Clause_new(learnt_clause
-            , sumConflicts
-            , ID
-        );
+        cl = cl_alloc.Clause_new(learnt_clause, ID);
         cl->isRed = true;
         cl->stats.glue = glue;
         cl->stats.id = ID;
-        #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         red_stats_extra.push_back(ClauseStatsExtra());
         cl->stats.extra_pos = red_stats_extra.size()-1;
         auto& ext_stats = red_stats_extra[cl->stats.extra_pos];
+        ext_stats.last_touched_any = sumConflicts;
+        #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         ext_stats.introduced_at_conflict = sumConflicts;
         ext_stats.orig_glue = glue;
         ext_stats.orig_size = cl->size();
@@ -1671,7 +1670,6 @@ Clause* Searcher::handle_last_confl(
         if (cl->stats.is_tracked) ext_stats.orig_ID = ID;
         if (sqlStats) sqlStats->update_id(ID, ID); // this is how we know it's tracked
         #endif
-        cl->stats.activity = 0.0f;
         ClOffset offset = cl_alloc.get_offset(cl);
         unsigned which_arr = 2;
 
@@ -1771,7 +1769,6 @@ bool Searcher::handle_conflict(PropBy confl)
         , glue_before_minim         //return glue before minimization here
         , size_before_minim         //return glue before minimization here
     );
-    solver->datasync->signal_new_long_clause(learnt_clause);
 
     uint32_t connects_num_communities = 0;
     STATS_DO(connects_num_communities = calc_connects_num_communities(learnt_clause));
@@ -1829,6 +1826,8 @@ bool Searcher::handle_conflict(PropBy confl)
         ID
     );
     attach_and_enqueue_learnt_clause<false>(cl, backtrack_level, true, ID);
+    //After it's in the FRAT proof, so the shared copy can be derived from it
+    solver->datasync->signal_new_long_clause(learnt_clause, glue);
 
     //Add decision-based clause
     // TODO FRAT -- this is broken because the reasons because of XOR for the propagations
@@ -2378,6 +2377,17 @@ void Searcher::sls_if_needed()
 {
     assert(okay());
     assert(decisionLevel() == 0);
+    if (conf.doSLS && conf.sls_walker_threads > 0) {
+        //Walkers run in the background, only their input and output is here
+        if (sumConflicts > next_sls) {
+            solver->sls_walkers->update_snapshot();
+            num_sls_called++;
+            next_sls = sumConflicts + 44000.0*conf.global_next_multiplier;
+        }
+        solver->sls_walkers->import();
+        return;
+    }
+
     if (conf.doSLS &&
         // If XORs are available, or there are BNNs, SLS will not work as intended
         // HOWEVER, it seems to STILL help, likely by setting values randomly
@@ -3442,6 +3452,7 @@ bool Searcher::check_order_heap_sanity() {
     check_all_in_vmtf_branch_strategy(tmp);
     order_heap_vsids.run_check([=] (uint32_t v) { assert(varData[v].removed == Removed::none); });
 
+    order_heap_vsids.flush_decreased();
     assert(order_heap_vsids.heap_property());
     assert(order_heap_rand.heap_property());
 
@@ -527,22 +527,23 @@ inline void Searcher::bump_cl_act(Clause* cl)
 
     assert(!cl->get_removed());
 
-    double new_val = cla_inc + (double)cl->stats.activity;
-    cl->stats.activity = (float)new_val;
+    float& act = red_stats_extra[cl->stats.extra_pos].activity;
+    double new_val = cla_inc + (double)act;
+    act = (float)new_val;
     if (max_cl_act < new_val) {
         max_cl_act = new_val;
     }
 
-    if (cl->stats.activity > 1e20F ) {
+    if (act > 1e20F ) {
         // Rescale. For STATS_NEEDED we rescale ALL
         #if !defined(STATS_NEEDED) && !defined (FINAL_PREDICTOR)
         for(ClOffset offs: longRedCls[2]) {
-            cl_alloc.ptr(offs)->stats.activity *= static_cast<float>(1e-20);
+            red_stats_extra[cl_alloc.ptr(offs)->stats.extra_pos].activity *= static_cast<float>(1e-20);
         }
         #else
         for(auto& lrcs: longRedCls) {
             for(ClOffset offs: lrcs) {
-                cl_alloc.ptr(offs)->stats.activity *= static_cast<float>(1e-20);
+                red_stats_extra[cl_alloc.ptr(offs)->stats.extra_pos].activity *= static_cast<float>(1e-20);
             }
         }
         #endif
@@ -618,12 +619,18 @@ inline void Searcher::vsids_bump_var_act(const uint32_t var)
         var_inc_vsids *= 1e-100;
     }
 
-    // Update order_heap with respect to new activity
+    // Update order_heap with respect to new activity. Deferred, so that all
+    // the bumps of a conflict are percolated together before the next pick
     if (order_heap_vsids.inHeap(var)) {
-        order_heap_vsids.decrease(var);
+        order_heap_vsids.decrease_later(var);
     }
 
-    SLOW_DEBUG_DO(if (rescaled) assert(order_heap_vsids.heap_property()));
+    #ifdef SLOW_DEBUG
+    if (rescaled) {
+        order_heap_vsids.flush_decreased();
+        assert(order_heap_vsids.heap_property());
+    }
+    #endif
 }
 
 template<class T> void Searcher::print_clause(const string& str, const T& cl) const
@@ -26,60 +26,192 @@ THE SOFTWARE.
 #include "solvertypesmini.h"
 
 #include <vector>
-#include <mutex>
 #include <atomic>
+#include <memory>
+#include <bit>
+#include <cassert>
 using std::vector;
-using std::mutex;
 
 namespace CMSat {
 
-class SharedData
+//Single-producer ring of 32b words. Only the owning thread writes to it,
+//every other thread reads it without locking. The head is an epoch counter:
+//it only ever grows, so readers keep their own position and only look at
+//what has been published since. Old data gets overwritten, readers that
+//fall more than a full ring behind notice and skip ahead.
+class ExportRing
 {
     public:
-        SharedData(const uint32_t _num_threads) : num_threads(_num_threads) { cur_thread_id.store(0); }
-        ~SharedData() {}
+        ExportRing(const uint32_t size_log2) :
+            mask((1ULL << size_log2)-1)
+            , data(1ULL << size_log2)
+        {
+            head.store(0);
+            reserved.store(0);
+        }
 
-        struct Spec {
-            Spec() : data(new vector<Lit>) {}
-            Spec(const Spec&) = delete;
-            Spec& operator=(const Spec&) = delete;
-
-            Spec(Spec&& other)
-            #ifndef _MSC_VER
-            noexcept
-            #endif
-            : data(std::move(other.data))
-            {
-                other.data = nullptr;
+        //Producer side. Publishes all of "words" at once. "reserved" is moved
+        //forward before any slot is overwritten, so readers can tell if
+        //what they copied has been clobbered
+        void write(const vector<uint32_t>& words)
+        {
+            assert(words.size() <= capacity());
+            const uint64_t end = written + words.size();
+            reserved.store(end, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for(const uint32_t w: words) {
+                data[written & mask].store(w, std::memory_order_relaxed);
+                written++;
             }
-            ~Spec() { clear(); }
-            vector<Lit>* data = nullptr;
-            void clear() {
-                delete data;
-                data = nullptr;
+            head.store(end, std::memory_order_release);
+        }
+
+        //Consumer side
+        uint64_t epoch() const { return head.load(std::memory_order_acquire); }
+        uint64_t capacity() const { return mask+1; }
+
+        //Copies [from, to) into "out". Returns FALSE if the producer may have
+        //overwritten some of it while we were copying, in which case "out"
+        //must be thrown away
+        bool read(const uint64_t from, const uint64_t to, vector<uint32_t>& out) const
+        {
+            assert(from <= to);
+            out.clear();
+            if (to - from > capacity()) return false;
+            for(uint64_t i = from; i < to; i++) {
+                out.push_back(data[i & mask].load(std::memory_order_relaxed));
             }
-        };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return reserved.load(std::memory_order_relaxed) - from <= capacity();
+        }
 
-        vector<Spec> bins;
-        std::mutex bin_mutex;
-        vector<lbool> value;
-        std::mutex unit_mutex;
-        std::atomic<int> cur_thread_id;
-        uint32_t num_threads;
+        size_t calc_memory_use() const
+        {
+            return data.capacity()*sizeof(std::atomic<uint32_t>);
+        }
+
+    private:
+        const uint64_t mask;
+        vector<std::atomic<uint32_t>> data;
+        std::atomic<uint64_t> head;
+        std::atomic<uint64_t> reserved;
+        uint64_t written = 0; //only touched by the producer
+};
+
+//Append-only log of 32b words, single producer, lock-free readers. Unlike
+//ExportRing nothing is ever lost: storage grows in chunks of doubling size
+//and chunks never move once allocated, so readers can index into them while
+//the producer keeps appending. Readers keep their own position and only
+//look at what was published since.
+class AppendLog
+{
+    public:
+        AppendLog()
+        {
+            for(auto& c: chunks) c.store(nullptr);
+            size.store(0);
+        }
+        ~AppendLog()
+        {
+            for(auto& c: chunks) delete[] c.load();
+        }
+        AppendLog(const AppendLog&) = delete;
+        AppendLog& operator=(const AppendLog&) = delete;
+
+        //Producer side
+        void push(const uint32_t word)
+        {
+            uint32_t chunk;
+            uint64_t off;
+            locate(written, chunk, off);
+            uint32_t* c = chunks[chunk].load(std::memory_order_relaxed);
+            if (c == nullptr) {
+                c = new uint32_t[chunk_size(chunk)];
+                chunks[chunk].store(c, std::memory_order_relaxed);
+            }
+            c[off] = word;
+            written++;
+        }
+        void publish() { size.store(written, std::memory_order_release); }
+
+        //Consumer side. Only positions below epoch() may be read
+        uint64_t epoch() const { return size.load(std::memory_order_acquire); }
+        uint32_t at(const uint64_t pos) const
+        {
+            uint32_t chunk;
+            uint64_t off;
+            locate(pos, chunk, off);
+            return chunks[chunk].load(std::memory_order_relaxed)[off];
+        }
 
-        size_t calc_memory_use_bins()
+        size_t calc_memory_use() const
         {
             size_t mem = 0;
-            mem += value.capacity()*sizeof(lbool);
-            mem += bins.capacity()*sizeof(Spec);
-            for(size_t i = 0; i < bins.size(); i++) {
-                if (bins[i].data) {
-                    mem += bins[i].data->capacity()*sizeof(Lit);
-                    mem += sizeof(vector<Lit>);
+            for(uint32_t i = 0; i < num_chunks; i++) {
+                if (chunks[i].load(std::memory_order_relaxed) != nullptr) {
+                    mem += chunk_size(i)*sizeof(uint32_t);
                 }
             }
             return mem;
         }
+
+    private:
+        static constexpr uint32_t first_chunk_log2 = 10;
+        static constexpr uint32_t num_chunks = 48;
+        static uint64_t chunk_size(const uint32_t chunk) { return 1ULL << (first_chunk_log2 + chunk); }
+
+        //Chunk "k" holds positions [B*(2^k-1), B*(2^(k+1)-1)) where B is the
+        //size of the first chunk
+        static void locate(const uint64_t pos, uint32_t& chunk, uint64_t& off)
+        {
+            const uint64_t x = (pos >> first_chunk_log2) + 1;
+            chunk = std::bit_width(x) - 1;
+            off = pos - (((1ULL << chunk) - 1) << first_chunk_log2);
+            assert(chunk < num_chunks);
+        }
+
+        std::atomic<uint32_t*> chunks[num_chunks];
+        std::atomic<uint64_t> size;
+        uint64_t written = 0; //only touched by the producer
+};
+
+class SharedData
+{
+    public:
+        SharedData(const uint32_t _num_threads, const uint32_t ring_size_log2 = 20) :
+            num_threads(_num_threads)
+        {
+            cur_thread_id.store(0);
+            for(uint32_t i = 0; i < num_threads; i++) {
+                rings.push_back(std::make_unique<ExportRing>(ring_size_log2));
+                units.push_back(std::make_unique<AppendLog>());
+            }
+        }
+        ~SharedData() {}
+
+        std::atomic<int> cur_thread_id;
+        uint32_t num_threads;
+
+        //Newly fixed top-level literals, one log per thread, OUTER numbering
+        vector<std::unique_ptr<AppendLog>> units;
+
+        //Learnt binary and short/low-glue clauses, one ring per thread.
+        //Records are [size, glue, lit_1 ... lit_size] in OUTER numbering
+        vector<std::unique_ptr<ExportRing>> rings;
+
+        size_t calc_memory_use_rings() const
+        {
+            size_t mem = 0;
+            for(const auto& r: rings) mem += r->calc_memory_use();
+            return mem;
+        }
+
+        size_t calc_memory_use_units() const
+        {
+            size_t mem = 0;
+            for(const auto& u: units) mem += u->calc_memory_use();
+            return mem;
+        }
 };
 
 }
@@ -49,13 +49,19 @@ vector<vector<uint8_t>> SLS::run_alter(const int64_t mems, uint32_t num) {
 
 lbool SLS::run_ccnr(const uint32_t num_sls_called)
 {
-    CMS_ccnr ccnr(solver);
     double mem_needed_mb = (double)approx_mem_needed()/(1000.0*1000.0);
     double maxmem = solver->conf.sls_memoutMB*solver->conf.var_and_mem_out_mult;
     if (mem_needed_mb < maxmem) {
-        lbool ret = ccnr.main(num_sls_called);
-        return ret;
+        //Assumptions are baked into the clauses, so don't keep those
+        if (!solver->assumptions.empty()) {
+            CMS_ccnr ccnr(solver);
+            return ccnr.main(num_sls_called);
+        }
+        if (solver->sls_ccnr == nullptr) solver->sls_ccnr = new CMS_ccnr(solver);
+        return solver->sls_ccnr->main(num_sls_called);
     }
+    delete solver->sls_ccnr;
+    solver->sls_ccnr = nullptr;
 
     verb_print(1, "[sls] would need "
         << std::setprecision(2) << std::fixed << mem_needed_mb
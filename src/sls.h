@@ -35,12 +35,12 @@ public:
     ~SLS() = default;
     lbool run(const uint32_t num_sls_called);
     vector<vector<uint8_t>> run_alter(const int64_t mems, uint32_t num);
+    uint64_t approx_mem_needed();
 
 private:
     Solver* solver;
 
     lbool run_ccnr(const uint32_t num_sls_called);
-    uint64_t approx_mem_needed();
 };
 
 } //end namespace CMSat
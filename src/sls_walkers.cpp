@@ -0,0 +1,336 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "sls_walkers.h"
+#include "solver.h"
+#include "sls.h"
+#include "ccnr.h"
+#include <algorithm>
+
+using namespace CMSat;
+
+SLSWalkers::SLSWalkers(Solver* _solver) :
+    solver(_solver)
+{}
+
+SLSWalkers::~SLSWalkers()
+{
+    stop();
+}
+
+void SLSWalkers::stop()
+{
+    if (threads.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        stopping = true;
+    }
+    interrupt = true;
+    cv.notify_all();
+    for(auto& t: threads) t.join();
+    verb_print(2, "[sls-walkers] stopped " << threads.size() << " walkers."
+        << " snapshots: " << num_snapshots << " imports: " << num_imported);
+    threads.clear();
+
+    stopping = false;
+    interrupt = false;
+    snapshot.reset();
+    results.clear();
+    fresh.clear();
+    have_result = false;
+}
+
+void SLSWalkers::update_snapshot()
+{
+    //It might not work well with few number of variables
+    if (solver->nVars() < 50 ||
+        solver->binTri.irredBins + solver->longIrredCls.size() < 10
+    ) {
+        verb_print(2, "[sls-walkers] too few variables & clauses");
+        return;
+    }
+
+    const uint32_t num_walkers = solver->conf.sls_walker_threads;
+    const double mem_needed_mb = (double)SLS(solver).approx_mem_needed()*num_walkers/(1000.0*1000.0);
+    const double maxmem = solver->conf.sls_memoutMB*solver->conf.var_and_mem_out_mult;
+    if (mem_needed_mb >= maxmem) {
+        verb_print(1, "[sls-walkers] would need "
+            << std::setprecision(2) << std::fixed << mem_needed_mb
+            << " MB but that's over limit of " << std::fixed << maxmem
+            << " MB -- skipping");
+        return;
+    }
+    if (solver->check_assumptions_contradict_foced_assignment()) return;
+
+    auto snap = std::make_shared<Snapshot>();
+    snap->outer.push_back(0);
+    snap->init_phase.push_back(false);
+    vector<uint32_t> sls_var(solver->nVars(), 0);
+    auto add_cl = [&](const auto& cl) -> bool {
+        const size_t start = snap->lits.size();
+        for(const Lit lit: cl) {
+            lbool val = solver->value(lit);
+            if (val == l_Undef) val = solver->lit_inside_assumptions(lit);
+            if (val == l_True) {
+                snap->lits.resize(start);
+                return true;
+            }
+            if (val == l_False) continue;
+
+            uint32_t& v = sls_var[lit.var()];
+            if (v == 0) {
+                v = snap->outer.size();
+                snap->outer.push_back(solver->map_inter_to_outer(lit.var()));
+                snap->init_phase.push_back(solver->varData[lit.var()].best_polarity);
+            }
+            snap->lits.push_back(lit.sign() ? -(int)v : (int)v);
+        }
+        //UNSAT under the assumptions, leave it to CDCL
+        if (snap->lits.size() == start) return false;
+        snap->lits.push_back(0);
+        snap->num_cls++;
+        return true;
+    };
+
+    Lit bin[2];
+    for(uint32_t i = 0; i < solver->nVars()*2; i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: solver->watches[lit]) {
+            if (w.isBin() && !w.red() && lit < w.lit2()) {
+                bin[0] = lit;
+                bin[1] = w.lit2();
+                if (!add_cl(bin)) return;
+            }
+        }
+    }
+    for(const ClOffset offs: solver->longIrredCls) {
+        if (!add_cl(*solver->cl_alloc.ptr(offs))) return;
+    }
+    if (snap->num_cls == 0) return;
+
+    snap->aspiration = solver->conf.sls_ccnr_asipire;
+    snap->mems_per_round = (int64_t)solver->conf.yalsat_max_mems*2*1000*1000;
+    snap->how_many_to_bump = solver->conf.sls_how_many_to_bump;
+    snap->bump_var_max_n_times = solver->conf.sls_bump_var_max_n_times;
+    snap->bump_type = solver->conf.sls_bump_type;
+    num_snapshots++;
+
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        snapshot = snap;
+    }
+    cv.notify_all();
+    if (threads.empty()) {
+        results.resize(num_walkers);
+        fresh.assign(num_walkers, 0);
+        for(uint32_t i = 0; i < num_walkers; i++) {
+            threads.emplace_back([this, i]() { walker(i); });
+        }
+    }
+    verb_print(2, "[sls-walkers] new snapshot vars: " << snap->outer.size()-1
+        << " cls: " << snap->num_cls << " walkers: " << threads.size());
+}
+
+void SLSWalkers::walker(const uint32_t id)
+{
+    std::shared_ptr<const Snapshot> snap;
+    std::unique_ptr<CCNR::ls_solver> ls;
+    vector<bool> phase;
+    bool solved = false;
+    uint64_t round = 0;
+    Result res;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mu);
+            //Once the snapshot is solved there is nothing to do until the next
+            cv.wait(lock, [&]() { return stopping || snapshot != snap || !solved; });
+            if (stopping) return;
+            if (snapshot != snap) {
+                snap = snapshot;
+                ls.reset();
+            }
+        }
+
+        if (!ls) {
+            ls = std::make_unique<CCNR::ls_solver>(snap->aspiration);
+            ls->set_interrupt(&interrupt);
+            ls->_num_vars = snap->outer.size()-1;
+            ls->_num_clauses = snap->num_cls;
+            ls->make_space();
+            int cl_num = 0;
+            for(const int l: snap->lits) {
+                if (l == 0) {
+                    cl_num++;
+                    continue;
+                }
+                ls->_clauses[cl_num].literals.push_back(CCNR::lit(l, cl_num));
+            }
+            for (int c = 0; c < ls->_num_clauses; c++) {
+                for(const CCNR::lit item: ls->_clauses[c].literals) {
+                    ls->_vars[item.var_num].literals.push_back(item);
+                }
+            }
+            ls->build_neighborhood();
+            phase = snap->init_phase;
+            solved = false;
+        }
+
+        //Different walkers, and rounds, must walk differently
+        ls->set_seed(1 + id*1000003 + round);
+        solved = ls->local_search(&phase, snap->mems_per_round);
+        if (interrupt) return;
+        //If the initial assignment is a solution, it's not copied to best
+        const vector<uint8_t>& sol = solved ? ls->_solution : ls->_best_solution;
+        for(size_t i = 1; i < phase.size(); i++) phase[i] = sol[i];
+
+        res.snap = snap;
+        res.cost = solved ? 0 : ls->get_best_cost();
+        res.solution = solved;
+        res.vals = sol;
+        calc_bumps(*snap, *ls, round, res.to_bump);
+        round++;
+
+        std::lock_guard<std::mutex> lock(mu);
+        std::swap(results[id], res);
+        fresh[id] = 1;
+        have_result = true;
+    }
+}
+
+void SLSWalkers::calc_bumps(
+    const Snapshot& snap, const CCNR::ls_solver& ls,
+    const uint64_t round, vector<uint32_t>& out) const
+{
+    out.clear();
+    uint32_t type = snap.bump_type;
+    if (type == 5) type = round % 3 == 0 ? 4 : 1;
+    if (type == 6) type = round % 3 == 0 ? 1 : 4;
+
+    vector<pair<long long, uint32_t>> by_score;
+    switch (type) {
+        case 1: {
+            //Variables of the heaviest clauses
+            vector<uint32_t> cls(ls._num_clauses);
+            for(uint32_t i = 0; i < cls.size(); i++) cls[i] = i;
+            std::sort(cls.begin(), cls.end(), [&](uint32_t a, uint32_t b) {
+                return ls._clauses[a].weight > ls._clauses[b].weight;
+            });
+            vector<uint32_t> times(ls._num_vars+1, 0);
+            for(const uint32_t c: cls) {
+                if (out.size() > snap.how_many_to_bump) break;
+                for(const CCNR::lit& l: ls._clauses[c].literals) {
+                    if (times[l.var_num] < snap.bump_var_max_n_times) {
+                        times[l.var_num]++;
+                        out.push_back(l.var_num);
+                    }
+                }
+            }
+            return;
+        }
+        case 3:
+            for(int v = 1; v <= ls._num_vars; v++) {
+                by_score.push_back({ls._vars[v].score, v});
+            }
+            break;
+        case 4:
+            //Only the most conflicting ones, bumping all of them at every
+            //restart would be too much
+            for(int v = 1; v <= ls._num_vars; v++) {
+                if (ls._conflict_ct[v] > 0) by_score.push_back({ls._conflict_ct[v], v});
+            }
+            break;
+        default:
+            assert(false && "No such SLS bump type");
+            exit(-1);
+    }
+
+    const size_t n = std::min<size_t>(snap.how_many_to_bump, by_score.size());
+    std::partial_sort(by_score.begin(), by_score.begin()+n, by_score.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    for(size_t i = 0; i < n; i++) out.push_back(by_score[i].second);
+}
+
+void SLSWalkers::import()
+{
+    assert(solver->decisionLevel() == 0);
+    if (!have_result.load(std::memory_order_relaxed)) return;
+
+    vector<Result> got;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        for(uint32_t i = 0; i < results.size(); i++) {
+            if (!fresh[i]) continue;
+            fresh[i] = 0;
+            got.push_back(std::move(results[i]));
+            results[i] = Result();
+        }
+        have_result = false;
+    }
+    if (got.empty()) return;
+
+    auto to_inter = [&](const Snapshot& snap, const uint32_t v) -> uint32_t {
+        const uint32_t outer = snap.outer[v];
+        if (outer >= solver->nVarsOuter()) return var_Undef;
+        const uint32_t inter = solver->map_outer_to_inter(outer);
+        if (inter >= solver->nVars()
+            || solver->varData[inter].removed != Removed::none
+        ) {
+            return var_Undef;
+        }
+        return inter;
+    };
+
+    //Phases from the best walker
+    const Result* best = &got[0];
+    for(const auto& r: got) {
+        if (r.cost < best->cost) best = &r;
+    }
+    if (solver->conf.sls_get_phase || best->solution) {
+        for(uint32_t v = 1; v < best->vals.size(); v++) {
+            const uint32_t inter = to_inter(*best->snap, v);
+            if (inter == var_Undef) continue;
+            solver->varData[inter].stable_polarity = best->vals[v];
+            if (best->solution) solver->varData[inter].best_polarity = best->vals[v];
+        }
+    }
+
+    //Bumps from all of them
+    uint32_t bumped = 0;
+    for(const auto& r: got) {
+        for(const uint32_t v: r.to_bump) {
+            const uint32_t inter = to_inter(*r.snap, v);
+            if (inter == var_Undef || solver->value(inter) != l_Undef) continue;
+            solver->bump_var_importance_all(inter);
+            bumped++;
+        }
+    }
+    if (solver->branch_strategy == branch::vsids) {
+        solver->vsids_decay_var_act();
+    }
+    num_imported++;
+
+    verb_print(2, "[sls-walkers] imported from " << got.size() << " walkers"
+        << " best cost: " << best->cost
+        << (best->solution ? " (solution)" : "")
+        << " bumped: " << bumped);
+}
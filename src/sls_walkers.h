@@ -0,0 +1,117 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <utility>
+
+namespace CMSat {
+
+using std::vector;
+using std::pair;
+
+class Solver;
+namespace CCNR {
+    class ls_solver;
+}
+
+/**
+@brief CCNR walkers that run on background threads while CDCL searches
+
+The searcher hands over a snapshot of the irredundant clauses every now and
+then. It is simplified by the level-0 assignment and the assumptions, and its
+variables are outer variables, so renumbering doesn't invalidate it. Each
+walker builds its own CCNR instance from the snapshot and runs it in rounds,
+continuing from its best assignment, until a newer snapshot arrives. After
+each round it posts its best assignment and the variables to bump, which the
+searcher picks up at its next restart through import(). Nothing found here is
+more than a hint, so a stale snapshot is harmless.
+*/
+class SLSWalkers
+{
+public:
+    explicit SLSWalkers(Solver* solver);
+    ~SLSWalkers();
+    SLSWalkers(const SLSWalkers&) = delete;
+    SLSWalkers& operator=(const SLSWalkers&) = delete;
+
+    ///Gives the walkers the current clauses, starting them if needed
+    void update_snapshot();
+    ///Applies what the walkers found since the last call. Must be called at
+    ///decision level 0. Cheap if there is nothing new
+    void import();
+    ///Joins the walkers. They restart at the next update_snapshot()
+    void stop();
+
+private:
+    struct Snapshot {
+        vector<uint32_t> outer; ///<Outer var of SLS var i at outer[i], [0] unused
+        vector<int> lits;       ///<Clauses in DIMACS form, each ended by 0
+        uint32_t num_cls = 0;
+        vector<bool> init_phase;
+
+        //From the config, walkers must not touch the solver
+        bool aspiration;
+        int64_t mems_per_round;
+        uint32_t how_many_to_bump;
+        uint32_t bump_var_max_n_times;
+        uint32_t bump_type;
+    };
+
+    struct Result {
+        std::shared_ptr<const Snapshot> snap;
+        int cost = 0;
+        bool solution = false;
+        vector<uint8_t> vals; ///<Indexed by SLS var
+        vector<uint32_t> to_bump; ///<SLS vars
+    };
+
+    void walker(const uint32_t id);
+    void calc_bumps(
+        const Snapshot& snap, const CCNR::ls_solver& ls,
+        uint64_t round, vector<uint32_t>& out) const;
+
+    Solver* solver;
+    vector<std::thread> threads;
+    std::mutex mu;
+    std::condition_variable cv;
+    std::shared_ptr<const Snapshot> snapshot;
+    bool stopping = false;
+    std::atomic<bool> interrupt{false};
+
+    vector<Result> results; ///<One slot per walker
+    vector<char> fresh;
+    std::atomic<bool> have_result{false};
+
+    //Stats
+    uint64_t num_snapshots = 0;
+    uint64_t num_imported = 0;
+};
+
+}
@@ -65,6 +65,8 @@ THE SOFTWARE.
 #include "xorfinder.h"
 #include "cardfinder.h"
 #include "sls.h"
+#include "sls_walkers.h"
+#include "ccnr_cms.h"
 #include "matrixfinder.h"
 #include "lucky.h"
 #include "get_clause_query.h"
@@ -113,6 +115,7 @@ Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter
     dist_impl_with_impl = new StrImplWImpl(this);
     clauseCleaner = new ClauseCleaner(this);
     varReplacer = new VarReplacer(this);
+    sls_walkers = new SLSWalkers(this);
     if (conf.doStrSubImplicit) {
         subsumeImplicit = new SubsumeImplicit(this);
     }
@@ -149,6 +152,8 @@ Solver::~Solver()
     delete breakid;
 #endif
     delete card_finder;
+    delete sls_walkers;
+    delete sls_ccnr;
 }
 
 void Solver::set_sqlite(
@@ -377,7 +382,7 @@ Clause* Solver::add_clause_int(
             attach_bin_clause(ps[0], ps[1], red, ID);
             return nullptr;
         default:
-            Clause* c = cl_alloc.Clause_new(ps, sumConflicts, ID);
+            Clause* c = cl_alloc.Clause_new(ps, ID);
             c->isRed = red;
             if (cl_stats) {
                 c->stats = *cl_stats;
@@ -391,6 +396,12 @@ Clause* Solver::add_clause_int(
                 //TODO red_stats_extra setup: glue, size, introduced_at_conflict
                 #endif
             }
+            if (red && c->stats.extra_pos == numeric_limits<uint32_t>::max()) {
+                //Fresh stats, e.g. redundant clause from the API
+                red_stats_extra.push_back(ClauseStatsExtra());
+                red_stats_extra.back().last_touched_any = sumConflicts;
+                c->stats.extra_pos = red_stats_extra.size()-1;
+            }
 
             //In class 'OccSimplifier' we don't need to attach normall
             if (attach_long) {
@@ -742,7 +753,8 @@ bool Solver::add_clause_outer(vector<Lit>& ps, const vector<Lit>& outer_ps, bool
     if (frat->incremental()) // import the "inner version with duplicates removed"
       *frat << "learning renumbered\n" << add << clstats.id << ps << fin;
 
-    std::sort(ps.begin(), ps.end());
+    //Bulk-loaded clauses come pre-sorted, and renumbering rarely breaks that
+    if (!std::is_sorted(ps.begin(), ps.end())) std::sort(ps.begin(), ps.end());
     if (red) assert(!frat->enabled() && "Cannot have both FRAT and adding of redundant clauses");
     Clause *cl = add_clause_int(
         ps
@@ -927,6 +939,9 @@ bool Solver::renumber_variables(bool must_renumber)
         inter_to_outer2[i*2+1] = inter_to_outer[i]*2+1;
     }
 
+    //The trail is invalidated below, other threads must get its units now
+    datasync->export_new_units();
+
     renumber_clauses(outer_to_inter);
     CNF::update_vars(outer_to_inter, inter_to_outer, inter_to_outer2);
     PropEngine::updateVars(outer_to_inter, inter_to_outer);
@@ -972,8 +987,6 @@ void Solver::new_vars(size_t n)
     if (conf.perform_occur_based_simp) {
         occsimplifier->new_vars(n);
     }
-
-    datasync->new_vars(n);
 }
 
 void Solver::new_var(
@@ -989,10 +1002,6 @@ void Solver::new_var(
         occsimplifier->new_var(orig_outer);
     }
 
-    if (orig_outer == numeric_limits<uint32_t>::max()) {
-        datasync->new_var(bva);
-    }
-
     //Too expensive
     //test_reflectivity_of_renumbering();
 }
@@ -1386,6 +1395,7 @@ lbool Solver::solve_with_assumptions(
     if (status == l_Undef) status = iterate_until_solved();
 
     end:
+    sls_walkers->stop();
     if (sqlStats) sqlStats->finishup(status);
     handle_found_solution(status, only_sampling_solution);
     unfill_assumptions_set();
@@ -2732,6 +2742,23 @@ bool Solver::add_clause_outside(const vector<Lit>& lits, bool red, bool restore)
     return add_clause_outer(tmp, lits, red, restore);
 }
 
+//Used when bulk-loading the CNF into many threads. No copy is made,
+//"lits" is clobbered. It cannot be used with FRAT.
+bool Solver::add_clause_outside_bulk(vector<Lit>& lits)
+{
+    assert(!frat->enabled());
+    if (!ok) return false;
+
+    SLOW_DEBUG_DO(check_too_large_variable_number(lits));
+    return add_clause_outer(lits, lits);
+}
+
+void Solver::reserve_long_irred_cls(const uint64_t num_cls, const uint64_t num_lits)
+{
+    cl_alloc.reserve(num_cls, num_lits);
+    longIrredCls.reserve(longIrredCls.size() + num_cls);
+}
+
 bool Solver::add_xor_clause_outside(const vector<Lit>& lits_out, bool rhs) {
     frat_func_start();
     if (!okay()) return false;
@@ -72,6 +72,8 @@ class ReduceDB;
 class InTree;
 class BreakID;
 class GetClauseQuery;
+class SLSWalkers;
+class CMS_ccnr;
 
 struct SolveStats
 {
@@ -92,6 +94,8 @@ class Solver : public Searcher
         void new_external_var();
         void new_external_vars(size_t n);
         bool add_clause_outside(const vector<Lit>& lits, bool red = false, bool restore = false);
+        bool add_clause_outside_bulk(vector<Lit>& lits);
+        void reserve_long_irred_cls(const uint64_t num_cls, const uint64_t num_lits);
         bool add_xor_clause_outside(const vector<uint32_t>& vars, const bool rhs);
         bool add_xor_clause_outside(const vector<Lit>& lits_out, bool rhs);
         bool add_bnn_clause_outside(
@@ -106,6 +110,7 @@ class Solver : public Searcher
         void  set_shared_data(SharedData* shared_data);
         vector<Lit> probe_inter_tmp;
         lbool probe_outside(Lit l, uint32_t& min_props);
+        Lit lookahead_split_lit(const vector<Lit>& cube);
         void set_max_confl(uint64_t max_confl);
         void set_outer_lit_weight(const Lit lit, const float weight);
         void changed_sampling_vars();
@@ -203,6 +208,8 @@ class Solver : public Searcher
         StrImplWImpl* dist_impl_with_impl = nullptr;
         CardFinder*            card_finder = nullptr;
         GetClauseQuery*        get_clause_query = nullptr;
+        SLSWalkers*            sls_walkers = nullptr;
+        CMS_ccnr*              sls_ccnr = nullptr; ///<Kept between SLS runs
 
         SearchStats sumSearchStats;
         PropStats sumPropStats;
@@ -413,6 +420,7 @@ class Solver : public Searcher
         bool oracle_sparsify(bool fast = false);
         void print_cs_ordering(const vector<OracleDat>& cs) const;
         template<bool bin_only> bool probe_inter(const Lit l, uint32_t& min_props);
+        bool lookahead_assume(const vector<Lit>& cube, const Lit extra);
         void reset_for_solving();
         vector<Lit> add_clause_int_tmp_cl;
         lbool iterate_until_solved();
@@ -197,6 +197,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , picosat_gate_limitK(70)
         , picosat_confl_limit(100)
         , varelim_check_resolvent_subs(false)
+        , varelim_helper_threads(0)
 
         //Subs, str limits for simplifier
         , subsumption_time_limitM(300)
@@ -257,7 +258,6 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Var-replacer
         , doFindAndReplaceEqLits(true)
-        , max_scc_depth (10000)
 
         //Iterative Alo Scheduling
         , simplify_at_startup(false)
@@ -301,6 +301,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxOccurRedMB    (600)
         , maxOccurRedLitLinkedM(50)
         , subsume_gothrough_multip(1.0)
+        , subsume_helper_threads(0)
+        , subsume_one_watch(1)
 
         //WalkSAT
         , doSLS(true)
@@ -314,6 +316,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , sls_how_many_to_bump(100)
         , sls_bump_var_max_n_times(100)
         , sls_bump_type(6)
+        , sls_walker_threads(0)
 
         //Distillation
         , do_distill_clauses(true)
@@ -360,6 +363,14 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Multi-thread, MPI
         , sync_every_confl(7000) //THREAD syncing
+        , share_long_cls(true)
+        , share_long_cls_max_size(8)
+        , share_long_cls_max_glue(2)
+        , cube_and_conquer(false)
+        , cube_init_per_thread(8)
+        , cube_confl_budget(20000)
+        , cube_max_len(30)
+        , cube_lookahead_cands(64)
         , every_n_mpi_sync(3) //every N thread sync, we do an MPI sync
         , thread_num(0)
         , is_mpi(false)
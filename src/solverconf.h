@@ -187,6 +187,11 @@ class GaussConf
     uint32_t min_matrix_rows; //The minimum matrix size -- no. of rows
     uint32_t max_num_matrices; //Maximum number of matrices
 
+    //Helper threads xor-ing rows during column elimination. 0 = off
+    uint32_t elim_helper_threads = 0;
+    //Only use the helpers if the elimination xors at least this many 64b words
+    uint32_t elim_helper_min_words = 1U << 15;
+
     //Matrix extraction config
     bool doMatrixFind = true;
     uint32_t min_gauss_xor_clauses = 2;
@@ -333,6 +338,7 @@ class DLL_PUBLIC SolverConf
         int picosat_gate_limitK;
         int picosat_confl_limit;
         int varelim_check_resolvent_subs;
+        uint32_t varelim_helper_threads;
 
         //Subs, str limits for simplifier
         long long subsumption_time_limitM;
@@ -394,13 +400,17 @@ class DLL_PUBLIC SolverConf
         //Predictor system
         std::string pred_conf_location;
         std::string pred_tables = "110";
+        #ifdef PREDICTOR_XGB
         std::string predictor_type = "xgb";
+        #else
+        std::string predictor_type = "trees";
+        #endif
+        uint32_t predictor_helper_threads = 0;
         std::string predict_best_feat_fname;
         #endif
 
         //Var-replacement
         int doFindAndReplaceEqLits;
-        int max_scc_depth;
 
         //Iterative Alo Scheduling
         int      simplify_at_startup; //simplify at 1st startup (only)
@@ -423,6 +433,8 @@ class DLL_PUBLIC SolverConf
         double maxOccurRedMB;
         double maxOccurRedLitLinkedM;
         double   subsume_gothrough_multip;
+        uint32_t subsume_helper_threads;
+        int      subsume_one_watch;
 
         //Walksat
         int doSLS;
@@ -436,6 +448,7 @@ class DLL_PUBLIC SolverConf
         uint32_t sls_how_many_to_bump;
         uint32_t sls_bump_var_max_n_times;
         uint32_t sls_bump_type;
+        uint32_t sls_walker_threads;
 
         //Distillation
         int      do_distill_clauses;
@@ -488,6 +501,14 @@ class DLL_PUBLIC SolverConf
 
         //Multi-thread, MPI
         unsigned long long sync_every_confl;
+        int      share_long_cls;
+        uint32_t share_long_cls_max_size;
+        uint32_t share_long_cls_max_glue;
+        int      cube_and_conquer;
+        uint32_t cube_init_per_thread;
+        uint64_t cube_confl_budget;
+        uint32_t cube_max_len;
+        uint32_t cube_lookahead_cands;
         uint32_t every_n_mpi_sync;
         unsigned thread_num;
         uint32_t is_mpi;
@@ -27,6 +27,17 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <string>
 #include <memory>
 #include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+
+#if !defined(_WIN32)
+#define CMS_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using std::numeric_limits;
 
@@ -69,19 +80,132 @@ struct CH {
     }
 };
 
+// A plain regular file mapped read-only into memory. The whole file is
+// visible at once, so the parser can walk it without copying it into
+// chunk-sized buffers. Falls back (open() returns false) on anything that
+// cannot be mapped, e.g. pipes or empty files.
+struct MMapView {
+    const char* data = nullptr;
+    size_t len = 0;
+};
+
+class MMapFile
+{
+public:
+    MMapFile() = default;
+    MMapFile(const MMapFile&) = delete;
+    MMapFile& operator=(const MMapFile&) = delete;
+    ~MMapFile() { close(); }
+
+    bool open(const std::string& fname)
+    {
+        #ifdef CMS_HAVE_MMAP
+        close();
+        int fd = ::open(fname.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        #ifdef MADV_SEQUENTIAL
+        madvise(p, st.st_size, MADV_SEQUENTIAL);
+        #endif
+        v.data = (const char*)p;
+        v.len = st.st_size;
+        return true;
+        #else
+        (void)fname;
+        return false;
+        #endif
+    }
+
+    void close()
+    {
+        #ifdef CMS_HAVE_MMAP
+        if (v.data) munmap((void*)v.data, v.len);
+        #endif
+        v = MMapView();
+    }
+
+    bool is_gzip() const
+    {
+        return v.len >= 2
+            && (unsigned char)v.data[0] == 0x1f
+            && (unsigned char)v.data[1] == 0x8b;
+    }
+
+    MMapView view() const { return v; }
+
+private:
+    MMapView v;
+};
+
+struct MM {
+    static constexpr bool zero_copy = true;
+    static inline const char* map(const MMapView& f, int64_t& size)
+    {
+        size = f.len;
+        return f.data;
+    }
+};
+
+template<typename B>
+constexpr bool stream_zero_copy()
+{
+    if constexpr (requires { B::zero_copy; }) return B::zero_copy;
+    else return false;
+}
+
 template<typename A, typename B>
 class StreamBuffer
 {
     A  in;
     void assureLookahead() {
-        if (pos >= size) {
-            pos  = 0;
-            size = B::read(buf.get(), 1, chunk_limit, in);
+        if constexpr (!stream_zero_copy<B>()) {
+            if (pos >= size) {
+                pos  = 0;
+                size = B::read(buf.get(), 1, chunk_limit, in);
+            }
         }
     }
-    int     pos;
-    int     size;
+    int64_t pos;
+    int64_t size;
     std::unique_ptr<char[]> buf;
+    const char* data;
+
+    //Parses a run of up to 7 digits at data[pos] with a single 8-byte load.
+    //Returns the number of digits consumed, or 0 if the slow path must be
+    //taken (no digit, 8+ digits, or too close to the end of the buffer).
+    template<class T>
+    inline int parse_digits_swar(T& val)
+    {
+        #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        if (size - pos < 8) return 0;
+        uint64_t x;
+        memcpy(&x, data + pos, 8);
+        const uint64_t lo = x - 0x3030303030303030ULL;
+        const uint64_t hi = x + 0x4646464646464646ULL;
+        const uint64_t nondigit = (lo | hi) & 0x8080808080808080ULL;
+        if (nondigit == 0) return 0;
+        const int n = std::countr_zero(nondigit) / 8;
+        if (n == 0) return 0;
+
+        uint64_t v = lo << (8*(8-n));
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+            + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        val = (T)v;
+        pos += n;
+        return n;
+        #else
+        (void)val;
+        return 0;
+        #endif
+    }
 
     void advance()
     {
@@ -97,13 +221,18 @@ public:
         in(i)
         , pos(0)
         , size(0)
-        , buf(new char[chunk_limit]())
     {
-        assureLookahead();
+        if constexpr (stream_zero_copy<B>()) {
+            data = B::map(in, size);
+        } else {
+            buf.reset(new char[chunk_limit]());
+            data = buf.get();
+            assureLookahead();
+        }
     }
 
     int  operator *  () {
-        return (pos >= size) ? EOF : buf[pos];
+        return (pos >= size) ? EOF : data[pos];
     }
     void operator ++ () {
         pos++;
@@ -177,6 +306,12 @@ public:
             advance();
         }
 
+        if (const int n = parse_digits_swar(val)) {
+            if (len) (*len) += n;
+            ret = mult*val;
+            return true;
+        }
+
         char c = value();
         if (c < '0' || c > '9') {
             std::cerr
@@ -32,10 +32,81 @@ THE SOFTWARE.
 #include <algorithm>
 #include <array>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define USE_SUBSET_AVX2
+#include <immintrin.h>
+#endif
+
 //#define VERBOSE_DEBUG
 
 using namespace CMSat;
 
+#ifdef USE_SUBSET_AVX2
+//The sorted-merge subset checks below skip over the literals of B that are
+//smaller than the next literal of A, 8 at a time. They visit the same
+//positions as the scalar loops, so results and costs are identical.
+namespace {
+const bool subset_has_avx2 = __builtin_cpu_supports("avx2");
+
+//First position p >= from with B[p] >= key, or b_sz if none.
+//Lits are < 2^31, so the signed compare is fine
+__attribute__((target("avx2"), always_inline))
+inline uint32_t first_not_below(
+    const Lit* B, uint32_t from, const uint32_t b_sz, const Lit key)
+{
+    const __m256i k = _mm256_set1_epi32((int)key.toInt());
+    for (; from + 8 <= b_sz; from += 8) {
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(B+from));
+        const uint32_t below = _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(k, b)));
+        if (below != 0xff) return from + __builtin_ctz(~below);
+    }
+    while (from < b_sz && B[from] < key) from++;
+    return from;
+}
+
+__attribute__((target("avx2")))
+bool subset_avx2(
+    const Lit* A, const uint32_t a_sz, const Lit* B, const uint32_t b_sz,
+    uint32_t& i, uint32_t& i2)
+{
+    i = 0;
+    i2 = 0;
+    while (true) {
+        i2 = first_not_below(B, i2, b_sz, A[i]);
+        if (i2 == b_sz || A[i] < B[i2]) return false;
+        i++;
+        if (i == a_sz) return true;
+        i2++;
+    }
+}
+
+__attribute__((target("avx2")))
+Lit subset1_avx2(
+    const Lit* A, const uint32_t a_sz, const Lit* B, const uint32_t b_sz,
+    uint32_t& i, uint32_t& i2)
+{
+    Lit retLit = lit_Undef;
+    i = 0;
+    i2 = 0;
+    while (true) {
+        //Until a literal is removed, ~A[i] in B is also a match
+        const Lit key = retLit == lit_Undef ? std::min(A[i], ~A[i]) : A[i];
+        i2 = first_not_below(B, i2, b_sz, key);
+        if (i2 == b_sz) return lit_Error;
+        if (retLit == lit_Undef && A[i] == ~B[i2]) {
+            retLit = B[i2];
+        } else if (A[i] != B[i2]) {
+            return lit_Error;
+        }
+        i++;
+        if (i == a_sz) return retLit;
+        i2++;
+    }
+}
+}
+#endif
+
 SubsumeStrengthen::SubsumeStrengthen(
     OccSimplifier* _simplifier
     , Solver* _solver
@@ -45,14 +116,30 @@ SubsumeStrengthen::SubsumeStrengthen(
 {
 }
 
-Sub0Ret SubsumeStrengthen::backw_sub_with_long(const ClOffset offset)
+void SubsumeStrengthen::find_subsumed_batch(const vector<ClOffset>& offsets)
+{
+    if (batch_subs.size() < offsets.size()) batch_subs.resize(offsets.size());
+    batch_cost.resize(offsets.size());
+    helpers->parallel_for(offsets.size(), [&](size_t b, size_t e) {
+        for(size_t k = b; k < e; k++) {
+            const Clause& cl = *solver->cl_alloc.ptr(offsets[k]);
+            batch_subs[k].clear();
+            batch_cost[k] = 0;
+            if (cl.freed() || cl.get_removed()) continue;
+            find_subsumed(offsets[k], cl, cl.abst, batch_subs[k], false, batch_cost[k]);
+        }
+    });
+}
+
+Sub0Ret SubsumeStrengthen::backw_sub_with_long(
+    const ClOffset offset, const vector<OccurClause>* found)
 {
     Clause& cl = *solver->cl_alloc.ptr(offset);
     assert(!cl.get_removed());
     assert(!cl.freed());
     VERBOSE_PRINT("subsume-ing with clause: " << cl);
 
-    Sub0Ret ret = subsume_and_unlink( offset , cl , cl.abst);
+    Sub0Ret ret = found ? unlink_subsumed(*found) : subsume_and_unlink(offset, cl, cl.abst);
 
     //If irred is subsumed by redundant, make the redundant into irred
     if (cl.red() && ret.subsumedIrred) {
@@ -61,12 +148,10 @@ Sub0Ret SubsumeStrengthen::backw_sub_with_long(const ClOffset offset)
 
     //Update stats
     cl.stats = ClauseStats::combineStats(cl.stats, ret.stats);
-    #if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
     if (cl.red()) {
         auto& extra_stats = solver->red_stats_extra[cl.stats.extra_pos];
         extra_stats = ClauseStatsExtra::combineStats(extra_stats, ret.stats_extra);
     }
-    #endif
 
     return ret;
 }
@@ -85,30 +170,35 @@ Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     , const T& ps
     , const cl_abst_type abs
 ) {
-    Sub0Ret ret;
-
     subs.clear();
     find_subsumed(offset, ps, abs, subs);
+    return unlink_subsumed(subs);
+}
+
+Sub0Ret SubsumeStrengthen::unlink_subsumed(const vector<OccurClause>& found)
+{
+    Sub0Ret ret;
 
     //Go through each clause that can be subsumed
-    for (const auto& occ_cl: subs) {
+    for (const auto& occ_cl: found) {
         if (!occ_cl.ws.isClause()) {
             continue;
         }
         ClOffset off = occ_cl.ws.get_offset();
         Clause *tmpcl = solver->cl_alloc.ptr(off);
 
+        //Found ahead of time, and removed since
+        if (tmpcl->get_removed()) continue;
+
         //-> ID kept will be 1st parameter
         //Stats will be merged together here then merged into the
         //subsuming clause's stats
         ret.stats = ClauseStats::combineStats(tmpcl->stats, ret.stats);
-        #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         if (tmpcl->red()) {
             ret.stats_extra = ClauseStatsExtra::combineStats(
                 solver->red_stats_extra[tmpcl->stats.extra_pos],
                 ret.stats_extra);
         }
-        #endif
         VERBOSE_PRINT("-> subsume removing:" << *tmpcl);
 
         ret.subsumedIrred |= !tmpcl->red();
@@ -162,13 +252,11 @@ bool SubsumeStrengthen::backw_sub_str_with_long(
 
             //Update stats
             cl.stats = ClauseStats::combineStats(cl.stats, cl2.stats);
-            #if defined(STATS_NEEDED) || defined (FINAL_PREDICTOR)
             if (cl.red() && cl2.red()) {
                 auto& extra_stats = solver->red_stats_extra[cl.stats.extra_pos];
                 auto& extra_stats2 = solver->red_stats_extra[cl2.stats.extra_pos];
                 extra_stats = ClauseStatsExtra::combineStats(extra_stats, extra_stats2);
             }
-            #endif
 
             //this will handle touching all vars for elim re-calc
             simplifier->unlink_clause(offset2, true, false, true);
@@ -185,12 +273,211 @@ bool SubsumeStrengthen::backw_sub_str_with_long(
     return solver->okay();
 }
 
+/**
+@brief Looks for a watched clause that subsumes "cl"
+
+Only watches of clauses at or after position "from" of one_watch_order are
+looked at, and only in the lists of the first "num_lits" literals. They are at
+the end of the watch lists, which are walked backwards, newest first.
+*/
+ClOffset SubsumeStrengthen::one_watch_subsumer(
+    const Clause& cl, const uint32_t from, const uint32_t num_lits)
+{
+    auto& seen = solver->seen;
+    ClOffset subsumer = CL_OFFSET_MAX;
+    for(const Lit l: cl) seen[l.toInt()] = 1;
+    for(uint32_t j = 0; j < num_lits; j++) {
+        const auto& ws = one_watch[cl[j].toInt()];
+        for(size_t i = ws.size(); i > 0 && ws[i-1] >= from; i--) {
+            *simplifier->limit_to_decrease -= 5;
+            const ClOffset offset2 = one_watch_order[ws[i-1]];
+            const Clause& cl2 = *solver->cl_alloc.ptr(offset2);
+            if (!subsetAbst(cl2.abst, cl.abst)
+                || !subsetAbst(cl2.abst2, cl.abst2)) continue;
+
+            *simplifier->limit_to_decrease -= (int64_t)cl2.size();
+            bool all_in = true;
+            for(const Lit l2: cl2) {
+                if (!seen[l2.toInt()]) {all_in = false; break;}
+            }
+            if (all_in) {subsumer = offset2; break;}
+        }
+        if (subsumer != CL_OFFSET_MAX) break;
+    }
+    for(const Lit l: cl) seen[l.toInt()] = 0;
+    return subsumer;
+}
+
+/**
+@brief Looks for the subsumers of one_watch_order[from, to) on the helpers
+
+The watches only hold clauses before "from" at this point, and nothing
+changes them while this runs, so the helpers only read. The subset test
+merges the sorted literals instead of using seen[], which is not per-thread.
+The lists are walked in the same order as in one_watch_subsumer(), and the
+literal the subsumer was found at is kept, see sub_long_with_long_one_watch().
+*/
+void SubsumeStrengthen::find_one_watch_subsumers_batch(
+    const uint32_t from, const uint32_t to)
+{
+    batch_subsumer.resize(to-from);
+    batch_subsumer_lit.resize(to-from);
+    batch_cost.resize(to-from);
+    helpers->parallel_for(to-from, [&](size_t b, size_t e) {
+        for(size_t k = b; k < e; k++) {
+            const Clause& cl = *solver->cl_alloc.ptr(one_watch_order[from+k]);
+            batch_subsumer[k] = CL_OFFSET_MAX;
+            batch_cost[k] = 0;
+            if (!cl.get_occur_linked()) continue;
+            for(uint32_t j = 0; j < cl.size(); j++) {
+                const auto& ws = one_watch[cl[j].toInt()];
+                for(size_t i = ws.size(); i > 0; i--) {
+                    batch_cost[k] += 5;
+                    const ClOffset offset2 = one_watch_order[ws[i-1]];
+                    const Clause& cl2 = *solver->cl_alloc.ptr(offset2);
+                    if (!subsetAbst(cl2.abst, cl.abst)
+                        || !subsetAbst(cl2.abst2, cl.abst2)) continue;
+                    if (subset(cl2, cl, batch_cost[k])) {
+                        batch_subsumer[k] = offset2;
+                        batch_subsumer_lit[k] = j;
+                        break;
+                    }
+                }
+                if (batch_subsumer[k] != CL_OFFSET_MAX) break;
+            }
+        }
+    });
+}
+
+/**
+@brief Forward subsumption of long clauses by long clauses
+
+Clauses are visited from short to long. A clause that is not subsumed is then
+watched on a single literal, its one with the fewest occurrences. Any clause
+that subsumes a later one has all its literals in it, so its watch is found
+among the watch lists of the later clause's literals. Those lists are much
+shorter than the occurrence lists that backward subsumption has to scan.
+
+With helper threads, the clauses are handled 1024 at a time. The helpers look
+for subsumers among the clauses before the batch, then the batch is walked
+here in order, looking only at the watches its own clauses added. These are
+newer, so they come first in each list, and only the lists up to the one the
+helpers found a subsumer in need to be looked at. Every clause therefore finds
+the same subsumer as without helpers.
+*/
+void SubsumeStrengthen::sub_long_with_long_one_watch()
+{
+    double my_time = cpu_time();
+    Sub0Ret sub0ret;
+    size_t tried = 0;
+    const int64_t orig_limit = simplifier->subsumption_time_limit;
+
+    one_watch_order.clear();
+    for(const ClOffset offs: simplifier->clauses) {
+        const Clause* cl = solver->cl_alloc.ptr(offs);
+        if (cl->freed() || cl->get_removed()) continue;
+        one_watch_order.push_back(offs);
+    }
+    *simplifier->limit_to_decrease -= (int64_t)one_watch_order.size()*10;
+    std::sort(one_watch_order.begin(), one_watch_order.end(),
+        [&](const ClOffset a, const ClOffset b) {
+            const uint32_t sz_a = solver->cl_alloc.ptr(a)->size();
+            const uint32_t sz_b = solver->cl_alloc.ptr(b)->size();
+            return sz_a < sz_b || (sz_a == sz_b && a < b);
+        });
+    one_watch.resize(solver->nVars()*2);
+
+    const uint32_t num_helpers = solver->conf.subsume_helper_threads;
+    if (num_helpers > 0 && !helpers) helpers = std::make_unique<HelperPool>(num_helpers);
+    uint32_t batch_from = 0;
+
+    for(uint32_t at = 0; at < one_watch_order.size(); at++) {
+        if (*simplifier->limit_to_decrease <= 0) break;
+        if (num_helpers > 0 && at % 1024 == 0) {
+            batch_from = at;
+            find_one_watch_subsumers_batch(at,
+                std::min<size_t>(at+1024, one_watch_order.size()));
+        }
+        tried++;
+        const ClOffset offset = one_watch_order[at];
+        Clause& cl = *solver->cl_alloc.ptr(offset);
+        *simplifier->limit_to_decrease -= 10 + (int64_t)cl.size();
+
+        //Like in backward subsumption, only clauses in the occurrence lists
+        //can get subsumed, but all can subsume
+        ClOffset subsumer = CL_OFFSET_MAX;
+        if (cl.get_occur_linked()) {
+            uint32_t num_lits = cl.size();
+            if (num_helpers > 0) {
+                *simplifier->limit_to_decrease -= batch_cost[at-batch_from];
+                if (batch_subsumer[at-batch_from] != CL_OFFSET_MAX) {
+                    num_lits = batch_subsumer_lit[at-batch_from]+1;
+                }
+            }
+            subsumer = one_watch_subsumer(cl, batch_from, num_lits);
+            if (subsumer == CL_OFFSET_MAX && num_helpers > 0) {
+                subsumer = batch_subsumer[at-batch_from];
+            }
+        }
+
+        if (subsumer == CL_OFFSET_MAX) {
+            Lit min_lit = cl[0];
+            for(const Lit l: cl) {
+                if (solver->watches[l].size() < solver->watches[min_lit].size())
+                    min_lit = l;
+            }
+            one_watch[min_lit.toInt()].push_back(at);
+            continue;
+        }
+
+        Clause& cl2 = *solver->cl_alloc.ptr(subsumer);
+        VERBOSE_PRINT("-> subsume removing:" << cl << " subsumed by: " << cl2);
+        if (cl2.red() && !cl.red()) simplifier->promote_red_to_irred(cl2);
+        cl2.stats = ClauseStats::combineStats(cl2.stats, cl.stats);
+        if (cl2.red() && cl.red()) {
+            auto& extra_stats = solver->red_stats_extra[cl2.stats.extra_pos];
+            extra_stats = ClauseStatsExtra::combineStats(
+                extra_stats, solver->red_stats_extra[cl.stats.extra_pos]);
+        }
+        simplifier->unlink_clause(offset, true, false, true);
+        sub0ret.numSubsumed++;
+    }
+    for(auto& ws: one_watch) ws.clear();
+
+    const double time_used = cpu_time() - my_time;
+    const bool time_out = (*simplifier->limit_to_decrease <= 0);
+    const double time_remain = float_div(*simplifier->limit_to_decrease, orig_limit);
+    verb_print(1, "[occ-sub-long-w-long-1w] rem cl: " << sub0ret.numSubsumed
+    << " tried: " << tried << "/" << one_watch_order.size()
+    << " (" << std::setprecision(1) << std::fixed
+    << stats_line_percent(tried, one_watch_order.size())
+    << "%)"
+    << solver->conf.print_times(time_used, time_out, time_remain));
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "occ-sub-long-w-long-1w"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+
+    runStats.sub0 += sub0ret;
+    runStats.subsumeTime += cpu_time() - my_time;
+}
+
 void SubsumeStrengthen::backw_sub_long_with_long()
 {
     //If clauses are empty, the system below segfaults
     if (simplifier->clauses.empty())
         return;
 
+    if (solver->conf.subsume_one_watch) {
+        sub_long_with_long_one_watch();
+        return;
+    }
+
     double my_time = cpu_time();
     size_t wenThrough = 0;
     Sub0Ret sub0ret;
@@ -199,23 +486,53 @@ void SubsumeStrengthen::backw_sub_long_with_long()
     const size_t max_go_through =
         solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size();
 
+    const uint32_t num_helpers = solver->conf.subsume_helper_threads;
+    if (num_helpers > 0 && !helpers) helpers = std::make_unique<HelperPool>(num_helpers);
+
     while (*simplifier->limit_to_decrease > 0
         && wenThrough < max_go_through
     ) {
-        *simplifier->limit_to_decrease -= 3;
-        wenThrough++;
-        if (solver->conf.verbosity >= 5 && wenThrough % 10000 == 0)
-            cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
+        if (num_helpers == 0) {
+            *simplifier->limit_to_decrease -= 3;
+            wenThrough++;
+            if (solver->conf.verbosity >= 5 && wenThrough % 10000 == 0)
+                cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
 
-        const size_t at = wenThrough % simplifier->clauses.size();
-        const ClOffset offset = simplifier->clauses[at];
-        Clause* cl = solver->cl_alloc.ptr(offset);
+            const size_t at = wenThrough % simplifier->clauses.size();
+            const ClOffset offset = simplifier->clauses[at];
+            Clause* cl = solver->cl_alloc.ptr(offset);
 
-        //Has already been removed
-        if (cl->freed() || cl->get_removed()) continue;
+            //Has already been removed
+            if (cl->freed() || cl->get_removed()) continue;
 
-        *simplifier->limit_to_decrease -= 10;
-        sub0ret += backw_sub_with_long(offset);
+            *simplifier->limit_to_decrease -= 10;
+            sub0ret += backw_sub_with_long(offset);
+            continue;
+        }
+
+        //Look for the clauses subsumed by the next batch in parallel, then
+        //unlink them here in the same order as above. Whatever an earlier
+        //clause of the batch removed is skipped, so the same set of clauses
+        //is removed.
+        batch.clear();
+        for(uint64_t w = wenThrough; batch.size() < 1024 && w < max_go_through; ) {
+            w++;
+            batch.push_back(simplifier->clauses[w % simplifier->clauses.size()]);
+        }
+        find_subsumed_batch(batch);
+
+        for(size_t k = 0; k < batch.size()
+            && *simplifier->limit_to_decrease > 0; k++
+        ) {
+            *simplifier->limit_to_decrease -= 3;
+            wenThrough++;
+            const ClOffset offset = batch[k];
+            Clause* cl = solver->cl_alloc.ptr(offset);
+            if (cl->freed() || cl->get_removed()) continue;
+
+            *simplifier->limit_to_decrease -= 10 + batch_cost[k];
+            sub0ret += backw_sub_with_long(offset, &batch_subs[k]);
+        }
     }
 
     const double time_used = cpu_time() - my_time;
@@ -319,6 +636,7 @@ void inline SubsumeStrengthen::fill_sub_str(
     const ClOffset offset
     , const T& cl
     , const cl_abst_type abs
+    , const cl_abst_type abs2
     , vector<OccurClause>& out_subsumed
     , vector<Lit>& out_lits
     , const Lit lit // this variable is in the "cl", but may be inverted
@@ -360,6 +678,7 @@ void inline SubsumeStrengthen::fill_sub_str(
         ClOffset offset2 = w.get_offset();
         const Clause& cl2 = *solver->cl_alloc.ptr(offset2);
         if (cl2.get_removed() || cl.size() > cl2.size()) continue;
+        if (!subsetAbst(abs2, cl2.abst2)) continue;
 
         *simplifier->limit_to_decrease -= (long)((cl.size() + cl2.size())/4);
         litSub = subset1(cl, cl2);
@@ -414,8 +733,9 @@ void SubsumeStrengthen::find_subsumed_and_strengthened(
     assert(minLit != lit_Undef);
     *simplifier->limit_to_decrease -= (long)cl.size();
 
-    fill_sub_str(offset, cl, abs, out_subsumed, out_lits, minLit, false);
-    fill_sub_str(offset, cl, abs, out_subsumed, out_lits, ~minLit, true);
+    const cl_abst_type abs2 = calcAbstraction2(cl);
+    fill_sub_str(offset, cl, abs, abs2, out_subsumed, out_lits, minLit, false);
+    fill_sub_str(offset, cl, abs, abs2, out_subsumed, out_lits, ~minLit, true);
 }
 
 //must be called from deal_with_added_long_and_bin
@@ -476,7 +796,7 @@ bool SubsumeStrengthen::handle_added_long_cl(const bool verbose)
 
 //A subsumes B (A <= B)
 template<class T1, class T2>
-bool SubsumeStrengthen::subset(const T1& A, const T2& B)
+bool SubsumeStrengthen::subset(const T1& A, const T2& B, int64_t& cost)
 {
     #ifdef MORE_DEBUG
     cout << "A:" << A << endl;
@@ -493,6 +813,13 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
     uint32_t i = 0;
     uint32_t i2 = 0;
     bool ret = false;
+    #ifdef USE_SUBSET_AVX2
+    if (B.size() >= 8 && subset_has_avx2) {
+        ret = subset_avx2(&A[0], A.size(), &B[0], B.size(), i, i2);
+        cost += (long)i2*4 + (long)i*4;
+        return ret;
+    }
+    #endif
     for (; i2 < B.size(); i2++) {
         assert(i2 == 0 || B[i2-1] < B[i2]);
 
@@ -505,7 +832,7 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
         }
     }
 
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    cost += (long)i2*4 + (long)i*4;
     return ret;
 }
 
@@ -529,6 +856,13 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
 
     uint32_t i = 0;
     uint32_t i2 = 0;
+    #ifdef USE_SUBSET_AVX2
+    if (B.size() >= 8 && subset_has_avx2) {
+        retLit = subset1_avx2(&A[0], A.size(), &B[0], B.size(), i, i2);
+        *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+        return retLit;
+    }
+    #endif
     for (; i2 < B.size(); i2++) {
         if (A[i] == ~B[i2] && retLit == lit_Undef) {
             retLit = B[i2];
@@ -552,7 +886,8 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
 }
 
 template<class T>
-uint32_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
+uint32_t SubsumeStrengthen::find_smallest_watchlist_for_clause(
+    const T& ps, int64_t& cost) const
 {
     uint32_t min_i = 0;
     size_t min_num = solver->watches[ps[min_i]].size();
@@ -563,7 +898,7 @@ uint32_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) cons
             min_num = this_num;
         }
     }
-    *simplifier->limit_to_decrease -= (long)ps.size();
+    cost += (long)ps.size();
 
     return min_i;
 }
@@ -581,6 +916,20 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     , vector<OccurClause>& out_subsumed //List of clauses
     , bool only_irred
 ) {
+    int64_t cost = 0;
+    find_subsumed(offset, ps, abs, out_subsumed, only_irred, cost);
+    *simplifier->limit_to_decrease -= cost;
+}
+
+//Does not touch the limit, only adds to "cost", so it can run on helper threads
+template<class T> void SubsumeStrengthen::find_subsumed(
+    const ClOffset offset
+    , const T& ps
+    , const cl_abst_type abs
+    , vector<OccurClause>& out_subsumed
+    , bool only_irred
+    , int64_t& cost
+) const {
     #ifdef VERBOSE_DEBUG
     cout << "find_subsumed: ";
     for (const Lit lit: ps) {
@@ -589,12 +938,13 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     cout << endl;
     #endif
 
-    const uint32_t smallest = find_smallest_watchlist_for_clause(ps);
+    const cl_abst_type abs2 = calcAbstraction2(ps);
+    const uint32_t smallest = find_smallest_watchlist_for_clause(ps, cost);
     const Lit lit = ps[smallest];
 
     //Go through the occur list of the literal that has the smallest occur list
-    watch_subarray occ = solver->watches[lit];
-    *simplifier->limit_to_decrease -= (long)occ.size()*8 + 40;
+    watch_subarray_const occ = solver->watches[lit];
+    cost += (long)occ.size()*8 + 40;
 
     for (const auto& w: occ) {
         if (w.isBin()) {
@@ -605,15 +955,16 @@ template<class T> void SubsumeStrengthen::find_subsumed(
         }
         if (!w.isClause()) continue;
 
-        *simplifier->limit_to_decrease -= 15;
+        cost += 15;
         if (w.get_offset() == offset || !subsetAbst(abs, w.getAbst())) continue;
 
         const ClOffset offset2 = w.get_offset();
-        Clause& cl2 = *solver->cl_alloc.ptr(offset2);
+        const Clause& cl2 = *solver->cl_alloc.ptr(offset2);
         if (ps.size() > cl2.size() || cl2.get_removed() || (only_irred && cl2.red())) continue;
+        if (!subsetAbst(abs2, cl2.abst2)) continue;
 
-        *simplifier->limit_to_decrease -= 50;
-        if (subset(ps, cl2)) {
+        cost += 50;
+        if (subset(ps, cl2, cost)) {
             out_subsumed.push_back(OccurClause(lit, w));
             VERBOSE_PRINT("subsumed cl offset: " << offset2);
         }
@@ -639,6 +990,11 @@ size_t SubsumeStrengthen::mem_used() const
     size_t b = 0;
     b += subs.capacity()*sizeof(ClOffset);
     b += subsLits.capacity()*sizeof(Lit);
+    b += one_watch.capacity()*sizeof(vector<uint32_t>);
+    for(const auto& ws: one_watch) b += ws.capacity()*sizeof(uint32_t);
+    b += one_watch_order.capacity()*sizeof(ClOffset);
+    b += batch_subsumer.capacity()*sizeof(ClOffset);
+    b += batch_subsumer_lit.capacity()*sizeof(uint32_t);
 
     return b;
 }
@@ -27,7 +27,9 @@ THE SOFTWARE.
 #include "clabstraction.h"
 #include "clause.h"
 #include "Vec.h"
+#include "helperpool.h"
 #include <vector>
+#include <memory>
 
 namespace CMSat {
 
@@ -51,7 +53,8 @@ public:
     void remove_binary_cl(const OccurClause& cl);
 
 
-    Sub0Ret backw_sub_with_long(const ClOffset offset);
+    Sub0Ret backw_sub_with_long(
+        const ClOffset offset, const vector<OccurClause>* found = nullptr);
 
     void backw_sub_with_impl(
         const vector<Lit>& lits,
@@ -90,6 +93,18 @@ public:
         , const bool only_irred = false
     );
 
+    //Same as above, but read-only: adds its cost to 'cost' instead of the
+    //time limit, so it can be called from helper threads
+    template<class T>
+    void find_subsumed(
+        const ClOffset offset
+        , const T& ps
+        , const cl_abst_type abs
+        , vector<OccurClause>& out_subsumed
+        , const bool only_irred
+        , int64_t& cost
+    ) const;
+
 private:
     Stats globalstats;
     Stats runStats;
@@ -104,9 +119,10 @@ private:
         , const T& ps
         , const cl_abst_type abs
     );
+    Sub0Ret unlink_subsumed(const vector<OccurClause>& found);
 
     template<class T>
-    uint32_t find_smallest_watchlist_for_clause(const T& ps) const;
+    uint32_t find_smallest_watchlist_for_clause(const T& ps, int64_t& cost) const;
 
     template<class T>
     void find_subsumed_and_strengthened(
@@ -122,6 +138,7 @@ private:
         const ClOffset offset
         , const T& ps
         , cl_abst_type abs
+        , cl_abst_type abs2
         , vector<OccurClause>& out_subsumed
         , vector<Lit>& out_lits
         , const Lit lit
@@ -129,12 +146,29 @@ private:
     );
 
     template<class T1, class T2>
-    bool subset(const T1& A, const T2& B);
+    static bool subset(const T1& A, const T2& B, int64_t& cost);
 
     template<class T1, class T2>
     Lit subset1(const T1& A, const T2& B);
 
     vector<OccurClause> subs;
+
+    //Parallel search for subsumed clauses in backw_sub_long_with_long()
+    void find_subsumed_batch(const vector<ClOffset>& batch);
+    std::unique_ptr<HelperPool> helpers;
+    vector<ClOffset> batch;
+    vector<vector<OccurClause>> batch_subs;
+    vector<int64_t> batch_cost;
+
+    //One-watch forward subsumption, see sub_long_with_long_one_watch()
+    void sub_long_with_long_one_watch();
+    ClOffset one_watch_subsumer(const Clause& cl, const uint32_t from, const uint32_t num_lits);
+    void find_one_watch_subsumers_batch(const uint32_t from, const uint32_t to);
+    vector<vector<uint32_t>> one_watch; //positions in one_watch_order
+    vector<ClOffset> one_watch_order;
+    vector<ClOffset> batch_subsumer;
+    vector<uint32_t> batch_subsumer_lit; //index of the literal it was found at
+
     vec<Watched> tmp;
     vector<Lit> subsLits;
     vector<Lit> tmpLits;
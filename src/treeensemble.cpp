@@ -0,0 +1,324 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "treeensemble.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+
+using namespace CMSat;
+using std::string;
+
+namespace {
+
+//Just enough JSON for XGBoost models. Arrays of numbers, which is what the
+//trees are made of, are kept as plain doubles.
+struct JVal {
+    enum class T {null_t, bool_t, num_t, str_t, arr_t, obj_t};
+    T t = T::null_t;
+    double num = 0;
+    string str;
+    vector<double> nums; ///<Arrays of numbers only
+    vector<JVal> arr;
+    vector<std::pair<string, JVal>> obj;
+
+    const JVal* get(const char* key) const
+    {
+        if (t != T::obj_t) return nullptr;
+        for(const auto& kv: obj) if (kv.first == key) return &kv.second;
+        return nullptr;
+    }
+};
+
+class JParser {
+public:
+    JParser(const char* _p, const char* _end) : p(_p), end(_end) {}
+
+    bool parse(JVal& v)
+    {
+        ws();
+        if (p == end) return false;
+        switch(*p) {
+            case '{': return parse_obj(v);
+            case '[': return parse_arr(v);
+            case '"': v.t = JVal::T::str_t; return parse_str(v.str);
+            case 't': v.t = JVal::T::bool_t; v.num = 1; return lit("true");
+            case 'f': v.t = JVal::T::bool_t; v.num = 0; return lit("false");
+            case 'n': v.t = JVal::T::null_t; return lit("null");
+            default: v.t = JVal::T::num_t; return parse_num(v.num);
+        }
+    }
+
+private:
+    void ws() { while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++; }
+
+    bool lit(const char* s)
+    {
+        const size_t n = strlen(s);
+        if ((size_t)(end-p) < n || strncmp(p, s, n) != 0) return false;
+        p += n;
+        return true;
+    }
+
+    bool parse_num(double& d)
+    {
+        //The buffer need not be 0-terminated, strtod() needs a copy
+        char tmp[64];
+        size_t n = 0;
+        while (p+n != end && n < sizeof(tmp)-1 && strchr("+-.0123456789eE", p[n])) n++;
+        if (n == 0) return false;
+        memcpy(tmp, p, n);
+        tmp[n] = 0;
+        char* e;
+        d = strtod(tmp, &e);
+        if (e != tmp+n) return false;
+        p += n;
+        return true;
+    }
+
+    bool parse_str(string& s)
+    {
+        p++;
+        s.clear();
+        while (p != end && *p != '"') {
+            if (*p == '\\') {
+                p++;
+                if (p == end) return false;
+            }
+            s += *p++;
+        }
+        if (p == end) return false;
+        p++;
+        return true;
+    }
+
+    bool parse_arr(JVal& v)
+    {
+        v.t = JVal::T::arr_t;
+        p++;
+        ws();
+        if (p != end && *p == ']') { p++; return true; }
+        while (true) {
+            ws();
+            if (p == end) return false;
+            if (v.arr.empty() && *p != '[' && *p != '{' && *p != '"' && *p != 't'
+                && *p != 'f' && *p != 'n'
+            ) {
+                double d;
+                if (!parse_num(d)) return false;
+                v.nums.push_back(d);
+            } else {
+                if (!v.nums.empty()) return false;
+                v.arr.emplace_back();
+                if (!parse(v.arr.back())) return false;
+            }
+            ws();
+            if (p == end) return false;
+            if (*p == ']') { p++; return true; }
+            if (*p++ != ',') return false;
+        }
+    }
+
+    bool parse_obj(JVal& v)
+    {
+        v.t = JVal::T::obj_t;
+        p++;
+        ws();
+        if (p != end && *p == '}') { p++; return true; }
+        while (true) {
+            ws();
+            if (p == end || *p != '"') return false;
+            v.obj.emplace_back();
+            if (!parse_str(v.obj.back().first)) return false;
+            ws();
+            if (p == end || *p++ != ':') return false;
+            if (!parse(v.obj.back().second)) return false;
+            ws();
+            if (p == end) return false;
+            if (*p == '}') { p++; return true; }
+            if (*p++ != ',') return false;
+        }
+    }
+
+    const char* p;
+    const char* end;
+};
+
+//Numbers in learner_model_param are strings, newer versions wrap them in []
+bool param_num(const JVal* v, double& d)
+{
+    if (v == nullptr) return false;
+    if (v->t == JVal::T::num_t) { d = v->num; return true; }
+    if (v->t != JVal::T::str_t) return false;
+    string s = v->str;
+    s.erase(std::remove_if(s.begin(), s.end(),
+        [](char c) { return c == '[' || c == ']'; }), s.end());
+    char* e;
+    d = strtod(s.c_str(), &e);
+    return !s.empty() && *e == 0;
+}
+
+}
+
+bool TreeEnsemble::load_xgb_json(const char* buf, size_t len, string& err)
+{
+    nodes.clear();
+    roots.clear();
+    max_feature = -1;
+
+    JVal doc;
+    JParser parser(buf, buf+len);
+    if (!parser.parse(doc)) {
+        err = "not valid JSON";
+        return false;
+    }
+
+    const JVal* learner = doc.get("learner");
+    const JVal* booster = learner ? learner->get("gradient_booster") : nullptr;
+    const JVal* bname = booster ? booster->get("name") : nullptr;
+    if (!bname || bname->str != "gbtree") {
+        err = "only 'gbtree' boosters are supported";
+        return false;
+    }
+
+    double base_score = 0.5;
+    const JVal* mparam = learner->get("learner_model_param");
+    if (mparam) {
+        double num_class = 0;
+        if (param_num(mparam->get("num_class"), num_class) && num_class > 1) {
+            err = "multi-class models are not supported";
+            return false;
+        }
+        param_num(mparam->get("base_score"), base_score);
+    }
+
+    const JVal* obj = learner->get("objective");
+    const JVal* oname = obj ? obj->get("name") : nullptr;
+    const string objective = oname ? oname->str : "reg:squarederror";
+    if (objective == "binary:logistic" || objective == "reg:logistic"
+        || objective == "binary:logitraw"
+    ) {
+        //logitraw has the same margin as logistic, it only skips the sigmoid
+        logistic = objective != "binary:logitraw";
+        base_margin = std::log(base_score/(1.0-base_score));
+    } else if (objective == "reg:squarederror" || objective == "reg:linear"
+        || objective == "reg:pseudohubererror"
+    ) {
+        logistic = false;
+        base_margin = base_score;
+    } else {
+        err = "unsupported objective '" + objective + "'";
+        return false;
+    }
+
+    const JVal* model = booster->get("model");
+    const JVal* trees = model ? model->get("trees") : nullptr;
+    if (!trees || trees->t != JVal::T::arr_t) {
+        err = "no trees in model";
+        return false;
+    }
+
+    for(const JVal& tree: trees->arr) {
+        const JVal* lc = tree.get("left_children");
+        const JVal* rc = tree.get("right_children");
+        const JVal* si = tree.get("split_indices");
+        const JVal* sc = tree.get("split_conditions");
+        const JVal* dl = tree.get("default_left");
+        if (!lc || !rc || !si || !sc || !dl) {
+            err = "tree misses a field";
+            return false;
+        }
+        const size_t n = lc->nums.size();
+        if (n == 0 || rc->nums.size() != n || si->nums.size() != n
+            || sc->nums.size() != n || dl->nums.size() != n
+        ) {
+            err = "tree fields differ in length";
+            return false;
+        }
+
+        //Breadth-first, placing both children of a node together
+        roots.push_back(nodes.size());
+        vector<std::pair<uint32_t, uint32_t>> todo; //(xgboost id, our index)
+        todo.push_back({0, (uint32_t)nodes.size()});
+        nodes.push_back(Node());
+        for(size_t at = 0; at < todo.size(); at++) {
+            const uint32_t id = todo[at].first;
+            Node& nd = nodes[todo[at].second];
+            const int64_t l = lc->nums[id];
+            const int64_t r = rc->nums[id];
+            nd.val = sc->nums[id];
+            if (l == -1) {
+                nd.feat = -1;
+                nd.left = 0;
+                nd.default_left = 0;
+                continue;
+            }
+            if (l < 0 || r < 0 || (size_t)l >= n || (size_t)r >= n
+                || todo.size() > n
+            ) {
+                err = "broken tree";
+                return false;
+            }
+            nd.feat = si->nums[id];
+            nd.default_left = dl->nums[id] != 0;
+            nd.left = nodes.size();
+            max_feature = std::max(max_feature, nd.feat);
+            todo.push_back({(uint32_t)l, (uint32_t)nodes.size()});
+            todo.push_back({(uint32_t)r, (uint32_t)nodes.size()+1});
+            nodes.push_back(Node());
+            nodes.push_back(Node());
+        }
+    }
+
+    return true;
+}
+
+void TreeEnsemble::predict(
+    const float* data, const size_t begin, const size_t end,
+    const uint32_t stride, float* out) const
+{
+    constexpr size_t block = 256;
+    for(size_t b = begin; b < end; b += block) {
+        const size_t e = std::min(end, b+block);
+        for(size_t i = b; i < e; i++) out[i] = base_margin;
+
+        for(const uint32_t root: roots) {
+            for(size_t i = b; i < e; i++) {
+                const float* row = data + i*stride;
+                uint32_t at = root;
+                while (nodes[at].feat >= 0) {
+                    const Node& nd = nodes[at];
+                    const float f = row[nd.feat];
+                    const bool right = std::isnan(f) ? !nd.default_left : !(f < nd.val);
+                    at = nd.left + right;
+                }
+                out[i] += nodes[at].val;
+            }
+        }
+
+        if (logistic) {
+            for(size_t i = b; i < e; i++) out[i] = 1.0f/(1.0f + std::exp(-out[i]));
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+namespace CMSat {
+
+using std::vector;
+
+/**
+@brief Evaluates a gradient boosted tree ensemble saved by XGBoost as JSON
+
+The trees are flattened into one array of nodes, breadth-first per tree, so
+the two children of a node are next to each other. Batches are scored a block
+of rows at a time, tree by tree, so a tree's nodes stay in cache while the
+whole block goes through it. Nothing here needs the XGBoost library.
+*/
+class TreeEnsemble
+{
+public:
+    ///Returns false, with the reason in 'err', if the model can't be used
+    bool load_xgb_json(const char* buf, size_t len, std::string& err);
+
+    ///out[i] = prediction for rows [begin, end). Row i starts at
+    ///data+i*stride, NaN marks a missing value
+    void predict(
+        const float* data, size_t begin, size_t end,
+        uint32_t stride, float* out) const;
+
+    uint32_t num_trees() const { return roots.size(); }
+    uint32_t num_features() const { return max_feature+1; }
+
+private:
+    struct Node {
+        float    val;  ///<Split threshold, or value of the leaf
+        int32_t  feat; ///<Feature split on, -1 for a leaf
+        uint32_t left; ///<Index of the left child, the right one is left+1
+        uint32_t default_left; ///<Go left if the feature is missing
+    };
+    vector<Node> nodes;
+    vector<uint32_t> roots;
+    float base_margin = 0;
+    bool logistic = false;
+    int32_t max_feature = -1;
+};
+
+}
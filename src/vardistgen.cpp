@@ -83,7 +83,7 @@ void VarDistGen::calc()
                 side.tot_num_lit_of_long_cls_it_appears_in += cl->size();
                 if (log_max != 0) {
                     d.tot_act_long_red_cls +=
-                        std::log2((double)cl->stats.activity + 10e-300) / log_max;
+                        std::log2((double)solver->red_stats_extra[cl->stats.extra_pos].activity + 10e-300) / log_max;
                 }
                 bump_sat_falsify(side, l);
                 side.sum_var_act_of_cls += tot_var_acts;
@@ -1035,7 +1035,7 @@ bool VarReplacer::replace_if_enough_is_found(const size_t limit, uint64_t* bogop
     solver->unfill_assumptions_set();
     if (replaced) *replaced = true;
 
-    const set<BinaryXor>& xors_found = scc_finder->get_binxors();
+    const vector<BinaryXor>& xors_found = scc_finder->get_binxors();
     for(BinaryXor bin_xor: xors_found) {
         if (!add_xor_as_bins(bin_xor)) goto end;
 
@@ -1263,8 +1263,3 @@ vector<pair<Lit, Lit>> VarReplacer::get_all_binary_xors_outer() const
     }
     return ret;
 }
-
-bool VarReplacer::get_scc_depth_warning_triggered() const
-{
-    return scc_finder->depth_warning_triggered();
-}
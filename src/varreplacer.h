@@ -110,7 +110,6 @@ class VarReplacer
         size_t mem_used() const;
         vector<std::pair<Lit, Lit>> get_all_binary_xors_outer() const;
         vector<uint32_t> get_vars_replacing_others() const;
-        bool get_scc_depth_warning_triggered() const;
         void delete_frat_cls();
 
     private:
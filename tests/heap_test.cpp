@@ -26,6 +26,9 @@ THE SOFTWARE.
 
 #include "src/heap.h"
 
+#include <vector>
+#include <random>
+
 using CMSat::Heap;
 
 struct Comp
@@ -94,6 +97,139 @@ TEST(heap_minim, inserted_inside)
     EXPECT_EQ(heap.inHeap(20), true);
 }
 
+//Orders by a key that can change, like the VSIDS activities
+struct KeyComp
+{
+    explicit KeyComp(const std::vector<double>& _key) : key(_key) {}
+    bool operator()(int a, int b) const
+    {
+        return key[a] < key[b];
+    }
+    const std::vector<double>& key;
+};
+
+template<int D>
+void check_build_insert_remove()
+{
+    std::mt19937 rnd(D);
+    std::vector<double> key(300);
+    for(auto& k: key) k = rnd()%1000;
+    KeyComp cmp(key);
+    Heap<KeyComp, D> heap(cmp);
+
+    std::vector<int> ns;
+    for(int i = 0; i < 200; i++) ns.push_back(i);
+    heap.build(ns);
+    EXPECT_EQ(heap.size(), 200u);
+    EXPECT_TRUE(heap.heap_property());
+
+    for(int i = 200; i < 300; i++) {
+        heap.insert(i);
+        EXPECT_TRUE(heap.heap_property());
+    }
+
+    double last = -1;
+    for(int i = 0; i < 300; i++) {
+        const int x = heap.removeMin();
+        EXPECT_FALSE(heap.inHeap(x));
+        EXPECT_GE(key[x], last);
+        last = key[x];
+        EXPECT_TRUE(heap.heap_property());
+    }
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(heap_dary, build_insert_remove_4)
+{
+    check_build_insert_remove<4>();
+}
+
+TEST(heap_dary, build_insert_remove_8)
+{
+    check_build_insert_remove<8>();
+}
+
+template<int D>
+void check_decrease_later()
+{
+    std::mt19937 rnd(D+1);
+    const int n = 1000;
+    std::vector<double> key(n);
+    for(auto& k: key) k = 1000 + rnd()%100000;
+    KeyComp cmp(key);
+    Heap<KeyComp, D> heap(cmp);
+    std::vector<int> ns;
+    for(int i = 0; i < n; i++) ns.push_back(i);
+    heap.build(ns);
+
+    for(int round = 0; round < 20; round++) {
+        //Many decreases, the same element several times in a row
+        for(int i = 0; i < 200; i++) {
+            const int x = rnd()%n;
+            if (!heap.inHeap(x)) continue;
+            for(int j = rnd()%3; j >= 0; j--) {
+                key[x] -= rnd()%1000;
+                heap.decrease_later(x);
+            }
+        }
+
+        //Removing flushes first, including elements decreased and then
+        //removed by this very call
+        const int x = heap.removeMin();
+        EXPECT_TRUE(heap.heap_property());
+        for(int i = 0; i < n; i++) {
+            if (heap.inHeap(i)) {
+                EXPECT_LE(key[x], key[i]);
+            }
+        }
+
+        //Decreased, then removed by a later removeMin() of this loop
+        if (!heap.empty()) {
+            const int y = heap.removeMin();
+            key[y] -= 1;
+            EXPECT_FALSE(heap.inHeap(y));
+        }
+    }
+
+    //Decreased, then dropped by clear()
+    std::vector<int> left;
+    while(!heap.empty()) {
+        const int x = heap.removeMin();
+        left.push_back(x);
+        EXPECT_TRUE(heap.heap_property());
+    }
+    for(size_t i = 1; i < left.size(); i++) {
+        EXPECT_LE(key[left[i-1]], key[left[i]]);
+    }
+
+    heap.build(ns);
+    for(int i = 0; i < n; i += 2) {
+        key[i] -= 50000;
+        heap.decrease_later(i);
+    }
+    heap.clear();
+    EXPECT_TRUE(heap.empty());
+    heap.insert(5);
+    heap.insert(6);
+    EXPECT_EQ(heap.size(), 2u);
+    EXPECT_TRUE(heap.heap_property());
+}
+
+TEST(heap_dary, decrease_later_4)
+{
+    check_decrease_later<4>();
+}
+
+TEST(heap_dary, decrease_later_8)
+{
+    check_decrease_later<8>();
+}
+
+TEST(heap_dary, decrease_later_binary)
+{
+    check_decrease_later<2>();
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
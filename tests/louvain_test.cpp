@@ -0,0 +1,146 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "src/louvain.h"
+
+using CMSat::Louvain;
+using std::vector;
+
+//Cliques on vertices [from, from+size)
+static void add_clique(vector<Louvain::Edge>& edges, uint32_t from, uint32_t size)
+{
+    for(uint32_t i = from; i < from+size; i++) {
+        for(uint32_t j = i+1; j < from+size; j++) {
+            edges.push_back(Louvain::Edge{i, j, 1.0f});
+        }
+    }
+}
+
+static uint32_t num_comms(const vector<uint32_t>& comm)
+{
+    uint32_t mx = 0;
+    for(const auto c: comm) mx = std::max(mx, c+1);
+    return mx;
+}
+
+TEST(louvain, two_cliques_one_bridge)
+{
+    vector<Louvain::Edge> edges;
+    add_clique(edges, 0, 5);
+    add_clique(edges, 5, 5);
+    edges.push_back(Louvain::Edge{4, 5, 1.0f});
+
+    Louvain l(10, edges);
+    const auto comm = l.compute();
+    ASSERT_EQ(comm.size(), 10u);
+    EXPECT_EQ(num_comms(comm), 2u);
+    for(uint32_t i = 1; i < 5; i++) {
+        EXPECT_EQ(comm[i], comm[0]);
+        EXPECT_EQ(comm[5+i], comm[5]);
+    }
+    EXPECT_NE(comm[0], comm[5]);
+    EXPECT_GT(l.modularity(), 0.4);
+    EXPECT_GE(l.num_levels(), 1u);
+}
+
+TEST(louvain, isolated_vertices)
+{
+    //Vertices 0, 4 and 9 have no edges
+    vector<Louvain::Edge> edges;
+    add_clique(edges, 1, 3);
+    add_clique(edges, 5, 4);
+
+    Louvain l(10, edges);
+    const auto comm = l.compute();
+    ASSERT_EQ(comm.size(), 10u);
+    EXPECT_EQ(num_comms(comm), 5u);
+    for(const uint32_t v: {0u, 4u, 9u}) {
+        for(uint32_t i = 0; i < 10; i++) {
+            if (i != v) {
+                EXPECT_NE(comm[v], comm[i]);
+            }
+        }
+    }
+    EXPECT_EQ(comm[1], comm[3]);
+    EXPECT_EQ(comm[5], comm[8]);
+}
+
+TEST(louvain, no_edges)
+{
+    vector<Louvain::Edge> edges;
+    Louvain l(4, edges);
+    const auto comm = l.compute();
+    ASSERT_EQ(comm.size(), 4u);
+    EXPECT_EQ(num_comms(comm), 4u);
+}
+
+TEST(louvain, duplicate_and_self_edges)
+{
+    vector<Louvain::Edge> edges;
+    add_clique(edges, 0, 5);
+    add_clique(edges, 5, 5);
+    edges.push_back(Louvain::Edge{4, 5, 1.0f});
+
+    //The same graph with every edge given as two halves, one of them in
+    //reverse, plus self edges everywhere
+    vector<Louvain::Edge> edges2;
+    for(const auto& e: edges) {
+        edges2.push_back(Louvain::Edge{e.a, e.b, 0.5f});
+        edges2.push_back(Louvain::Edge{e.b, e.a, 0.5f});
+    }
+    for(uint32_t i = 0; i < 10; i++) {
+        edges2.push_back(Louvain::Edge{i, i, 3.0f});
+    }
+    //Louvain consumes the edge list
+    Louvain plain(10, edges);
+    const auto comm_plain = plain.compute();
+    EXPECT_TRUE(edges.empty());
+
+    Louvain merged(10, edges2);
+    const auto comm_merged = merged.compute();
+
+    EXPECT_EQ(comm_plain, comm_merged);
+    EXPECT_NEAR(plain.modularity(), merged.modularity(), 1e-9);
+}
+
+TEST(louvain, self_edges_only)
+{
+    vector<Louvain::Edge> edges;
+    for(uint32_t i = 0; i < 3; i++) {
+        edges.push_back(Louvain::Edge{i, i, 1.0f});
+    }
+    Louvain l(3, edges);
+    const auto comm = l.compute();
+    ASSERT_EQ(comm.size(), 3u);
+    EXPECT_EQ(num_comms(comm), 3u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -77,7 +77,7 @@ TEST(scc_test, find_circle_3)
 
     SCCFinder scc(&s);
     scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 3U);
+    EXPECT_EQ(scc.get_binxors().size(), 2U);
 }
 
 TEST(scc_test, find_two_circle2_3)
@@ -97,7 +97,7 @@ TEST(scc_test, find_two_circle2_3)
 
     SCCFinder scc(&s);
     scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 6U);
+    EXPECT_EQ(scc.get_binxors().size(), 4U);
 }
 
 TEST(scc_test, find_1_diff)
@@ -133,27 +133,9 @@ TEST(scc_test, find_0)
 }
 
 
-TEST(scc_test, limit_test4)
-{
-    SolverConf conf;
-    conf.max_scc_depth = 4;
-
-    std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
-    Solver s(&conf, tmp.get());
-    s.new_vars(4);
-    s.add_clause_outside(str_to_cl("1, 2"));
-    s.add_clause_outside(str_to_cl("-2, 3"));
-    s.add_clause_outside(str_to_cl("-3, -1"));
-
-    SCCFinder scc(&s);
-    scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 3U);
-}
-
-TEST(scc_test, limit_test3)
+TEST(scc_test, find_circle_neg)
 {
     SolverConf conf;
-    conf.max_scc_depth = 3;
 
     std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
     Solver s(&conf, tmp.get());
@@ -164,24 +146,25 @@ TEST(scc_test, limit_test3)
 
     SCCFinder scc(&s);
     scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 0U);
+    EXPECT_EQ(scc.get_binxors().size(), 2U);
 }
 
-TEST(scc_test, limit_test2)
+TEST(scc_test, find_long_chain)
 {
     SolverConf conf;
-    conf.max_scc_depth = 2;
 
     std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
     Solver s(&conf, tmp.get());
-    s.new_vars(4);
-    s.add_clause_outside(str_to_cl("1, 2"));
-    s.add_clause_outside(str_to_cl("-2, 3"));
-    s.add_clause_outside(str_to_cl("-3, -1"));
+    const uint32_t n = 200000;
+    s.new_vars(n);
+    for(uint32_t i = 0; i < n; i++) {
+        const uint32_t next = (i+1) % n;
+        s.add_clause_outside({Lit(i, true), Lit(next, false)});
+    }
 
     SCCFinder scc(&s);
     scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 0U);
+    EXPECT_EQ(scc.get_binxors().size(), n-1);
 }
 
 int main(int argc, char **argv) {
@@ -0,0 +1,178 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/treeensemble.h"
+
+using CMSat::TreeEnsemble;
+
+//Tree 0: node 0 splits on f1 < 2.5, missing goes left. Its left child, node
+//3, splits on f0 < -1, missing goes right. The node ids are deliberately not
+//in breadth-first order. Tree 1 is a single leaf.
+static const char* two_trees(const char* objective, const char* base_score)
+{
+    static std::string js;
+    js = std::string(R"({"learner":{"gradient_booster":{"name":"gbtree","model":{"trees":[
+      {"left_children":[3,-1,-1,4,-1],"right_children":[1,-1,-1,2,-1],
+       "split_indices":[1,0,0,0,0],"split_conditions":[2.5,0.7,0.1,-1,-0.3],
+       "default_left":[1,0,0,0,0]},
+      {"left_children":[-1],"right_children":[-1],"split_indices":[0],
+       "split_conditions":[0.05],"default_left":[0]}
+    ]}},"learner_model_param":{"base_score":")") + base_score
+    + R"(","num_class":"0","num_feature":"2"},
+    "objective":{"name":")" + objective + R"("}},"version":[2,0,0]})";
+    return js.c_str();
+}
+
+static const float nan_f = NAN;
+static const float rows[] = {
+    0, 0,
+    -2, 3,
+    0, 3,
+    nan_f, nan_f,
+    -5, nan_f
+};
+static const double margins[] = {0.15, 0.75, 0.75, 0.15, -0.25};
+
+TEST(treeensemble, load)
+{
+    TreeEnsemble t;
+    std::string err;
+    const char* js = two_trees("reg:squarederror", "[0E0]");
+    ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+    EXPECT_EQ(t.num_trees(), 2u);
+    EXPECT_EQ(t.num_features(), 2u);
+}
+
+TEST(treeensemble, out_of_order_ids)
+{
+    TreeEnsemble t;
+    std::string err;
+    const char* js = two_trees("reg:squarederror", "[0E0]");
+    ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+
+    float out[3];
+    t.predict(rows, 0, 3, 2, out);
+    for(int i = 0; i < 3; i++) EXPECT_NEAR(out[i], margins[i], 1e-6);
+}
+
+TEST(treeensemble, missing_values)
+{
+    TreeEnsemble t;
+    std::string err;
+    const char* js = two_trees("reg:squarederror", "[0E0]");
+    ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+
+    //Only the rows with missing values, out is indexed by row
+    float out[5];
+    t.predict(rows, 3, 5, 2, out);
+    EXPECT_NEAR(out[3], margins[3], 1e-6);
+    EXPECT_NEAR(out[4], margins[4], 1e-6);
+}
+
+TEST(treeensemble, base_score)
+{
+    TreeEnsemble t;
+    std::string err;
+    const char* js = two_trees("reg:squarederror", "[5E-1]");
+    ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+
+    float out[5];
+    t.predict(rows, 0, 5, 2, out);
+    for(int i = 0; i < 5; i++) EXPECT_NEAR(out[i], margins[i]+0.5, 1e-6);
+}
+
+TEST(treeensemble, logistic)
+{
+    TreeEnsemble t;
+    std::string err;
+    //A base score of 0.5 is a margin of 0
+    const char* js = two_trees("binary:logistic", "[5E-1]");
+    ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+
+    float out[5];
+    t.predict(rows, 0, 5, 2, out);
+    for(int i = 0; i < 5; i++) {
+        EXPECT_NEAR(out[i], 1.0/(1.0+std::exp(-margins[i])), 1e-6);
+    }
+}
+
+TEST(treeensemble, logitraw)
+{
+    //The base score is a probability as with logistic, only the output
+    //stays a margin
+    const std::pair<const char*, double> base_scores[] = {
+        {"[5E-1]", 0.5}, {"[8E-1]", 0.8}};
+    for(const auto& [bs, p]: base_scores) {
+        TreeEnsemble t;
+        std::string err;
+        const char* js = two_trees("binary:logitraw", bs);
+        ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+
+        float out[5];
+        t.predict(rows, 0, 5, 2, out);
+        for(int i = 0; i < 5; i++) {
+            EXPECT_NEAR(out[i], margins[i] + std::log(p/(1.0-p)), 1e-6);
+        }
+    }
+}
+
+TEST(treeensemble, large_batch)
+{
+    TreeEnsemble t;
+    std::string err;
+    const char* js = two_trees("reg:squarederror", "[0E0]");
+    ASSERT_TRUE(t.load_xgb_json(js, strlen(js), err)) << err;
+
+    //More rows than one block
+    const size_t n = 1000;
+    std::vector<float> data;
+    for(size_t i = 0; i < n; i++) {
+        data.push_back(rows[(i%5)*2]);
+        data.push_back(rows[(i%5)*2+1]);
+    }
+    std::vector<float> out(n);
+    t.predict(data.data(), 0, n, 2, out.data());
+    for(size_t i = 0; i < n; i++) EXPECT_NEAR(out[i], margins[i%5], 1e-6);
+}
+
+TEST(treeensemble, reject_unsupported)
+{
+    TreeEnsemble t;
+    std::string err;
+    const char* js = two_trees("multi:softprob", "[0E0]");
+    EXPECT_FALSE(t.load_xgb_json(js, strlen(js), err));
+    EXPECT_FALSE(err.empty());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}